@@ -0,0 +1,340 @@
+// 性能基准测试程序：对游戏中的热点函数做微基准测试，结果以JSON输出（ns/op 与 allocs/op）
+// 用法：pvz-bench -platform offscreen [--filter 名称] [--min-time 毫秒] [--output 文件]
+
+#include <QtCore>
+#include <QtWidgets>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "MainView.h"
+#include "GameScene.h"
+#include "GameLevelData.h"
+#include "ImageManager.h"
+#include "Coordinate.h"
+#include "Plant.h"
+#include "Zombie.h"
+#include "Timer.h"
+#include "Animate.h"
+#include "MouseEventPixmapItem.h"
+#include "JobSystem.h"
+
+// 统计全局 operator new 的调用次数
+// 注意：Qt 容器的数据区由 Qt 库内部用 malloc 分配，不在统计范围内；
+// Windows 下替换 operator new 也只对本程序自身的代码生效
+static std::atomic<qint64> gAllocCount(0);
+
+void *operator new(std::size_t size)
+{
+    gAllocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// 基准测试用关卡：不加载资源、不播放音乐，场景只作为容器使用
+class BenchLevelData: public GameLevelData_1
+{
+public:
+    void loadAccess(GameScene *) override {}
+};
+
+// 暴露 GameScene 中受保护的出怪函数
+class BenchScene: public GameScene
+{
+public:
+    BenchScene() : GameScene(new BenchLevelData) {}
+
+    using GameScene::advanceFlag;
+    using GameScene::selectFlagZombie;
+
+    // 删除场景中挂起的 Timer（基准测试不运行事件循环，计时器永远不会触发）
+    void clearTimers()
+    {
+        for (QTimer *timer: findChildren<QTimer *>(QString(), Qt::FindDirectChildrenOnly)) {
+            if (dynamic_cast<Timer *>(timer))
+                delete timer;
+        }
+    }
+};
+
+class BenchRunner
+{
+public:
+    BenchRunner(const QString &filter, qint64 minTimeMs)
+            : filter(filter), minTimeNs(minTimeMs * 1000000)
+    {}
+
+    // body(n) 需要执行 n 次被测操作；迭代次数倍增直到单轮耗时达到 minTime
+    void run(const QString &name, const std::function<void(qint64)> &body)
+    {
+        if (!filter.isEmpty() && !name.contains(filter))
+            return;
+        body(1);    // 预热（填充缓存、创建原型等）
+        qint64 n = 1;
+        forever {
+            qint64 allocsBefore = gAllocCount.load();
+            QElapsedTimer timer;
+            timer.start();
+            body(n);
+            qint64 elapsed = timer.nsecsElapsed();
+            qint64 allocs = gAllocCount.load() - allocsBefore;
+            if (elapsed >= minTimeNs || n >= (Q_INT64_C(1) << 30)) {
+                QJsonObject result;
+                result["name"] = name;
+                result["iterations"] = n;
+                result["ns_per_op"] = double(elapsed) / n;
+                result["allocs_per_op"] = double(allocs) / n;
+                results.append(result);
+                QTextStream(stderr) << QString("%1  %2 ns/op  %3 allocs/op  (%4 iterations)\n")
+                        .arg(name, -40)
+                        .arg(double(elapsed) / n, 0, 'f', 1)
+                        .arg(double(allocs) / n, 0, 'f', 2)
+                        .arg(n);
+                break;
+            }
+            // 按已测得的速度估算下一轮次数，限制在 2~100 倍之间
+            qint64 predicted = elapsed > 0 ? n * minTimeNs / elapsed * 6 / 5 + 1 : n * 100;
+            n = qBound(n * 2, predicted, n * 100);
+        }
+    }
+
+    QJsonArray results;
+
+private:
+    QString filter;
+    qint64 minTimeNs;
+};
+
+// 防止编译器把被测调用优化掉
+static volatile int gIntSink;
+static volatile double gDoubleSink;
+
+static void benchCoordinate(BenchRunner &runner)
+{
+    Coordinate lawn(0);
+    runner.run("Coordinate::getCol", [&](qint64 n) {
+        int acc = 0;
+        for (qint64 i = 0; i < n; ++i)
+            acc += lawn.getCol(100 + (i & 1023) * 0.8);
+        gIntSink = acc;
+    });
+    runner.run("Coordinate::getRow", [&](qint64 n) {
+        int acc = 0;
+        for (qint64 i = 0; i < n; ++i)
+            acc += lawn.getRow((i & 511) * 1.1);
+        gIntSink = acc;
+    });
+    runner.run("Coordinate::getX", [&](qint64 n) {
+        double acc = 0;
+        for (qint64 i = 0; i < n; ++i)
+            acc += lawn.getX(int(i % 14) - 2);
+        gDoubleSink = acc;
+    });
+    runner.run("Coordinate::getY", [&](qint64 n) {
+        double acc = 0;
+        for (qint64 i = 0; i < n; ++i)
+            acc += lawn.getY(int(i % 7));
+        gDoubleSink = acc;
+    });
+}
+
+static void benchImageManager(BenchRunner &runner)
+{
+    const QStringList paths = {
+        "interface/SunBack.png", "interface/Shovel.png", "interface/ShovelBack.png", "interface/background1.jpg"
+    };
+    runner.run("ImageManager::load/hit", [&](qint64 n) {
+        int acc = 0;
+        for (qint64 i = 0; i < n; ++i)
+            acc += gImageCache->load(paths[int(i % paths.size())]).width();
+        gIntSink = acc;
+    });
+    runner.run("ImageManager::load/miss", [&](qint64 n) {
+        int acc = 0;
+        for (qint64 i = 0; i < n; ++i) {
+            ImageManager cache;
+            acc += cache.load(paths[int(i % paths.size())]).width();
+        }
+        gIntSink = acc;
+    });
+}
+
+// N 个僵尸 × M 个触发器时执行一次 monitorTick 的耗时
+// 植物只种在前5列、僵尸停在 600~880 且速度为 0，保证测量的是纯扫描开销而不会进入啃食流程
+static void benchMonitorTick(BenchRunner &runner, int zombieCount, int triggerCount)
+{
+    BenchScene scene;
+    for (int i = 0; i < triggerCount; ++i) {
+        PlantInstance *plant = scene.customSpecial("oPeashooter", 1 + i / 5, 1 + i % 5);
+        plant->canTrigger = false;
+    }
+    Zombie *zombie = scene.getZombieProtoType("oZombie");
+    for (int i = 0; i < zombieCount; ++i) {
+        ZombieInstance *zombieInstance = scene.spawnZombie(zombie, 1 + i % 5);
+        qreal x = 600 + (i * 37) % 280;
+        zombieInstance->speed = 0;
+        zombieInstance->X = x - zombie->beAttackedPointL;
+        zombieInstance->attackedLX = zombieInstance->ZX = x;
+        zombieInstance->attackedRX = zombieInstance->X + zombie->beAttackedPointR;
+        zombieInstance->picture->setX(zombieInstance->X);
+    }
+    runner.run(QString("GameScene::monitorTick/%1x%2").arg(zombieCount).arg(triggerCount), [&](qint64 n) {
+        for (qint64 i = 0; i < n; ++i)
+            scene.monitorTick();
+    });
+}
+
+static void benchSelectFlagZombie(BenchRunner &runner)
+{
+    BenchScene scene;
+    scene.advanceFlag();    // 推进到第1波，使候选僵尸列表非空
+    scene.clearTimers();
+    runner.run("GameScene::selectFlagZombie", [&](qint64 n) {
+        for (qint64 i = 0; i < n; ++i) {
+            scene.selectFlagZombie(10);
+            if ((i & 255) == 255)
+                scene.clearTimers();
+        }
+        scene.clearTimers();
+    });
+}
+
+// 子弹单步：每颗子弹从 150 开始走 60 步后换新，包含每步新建的 Timer
+static void benchBulletMove(BenchRunner &runner)
+{
+    BenchScene scene;
+    runner.run("Bullet::move", [&](qint64 n) {
+        Bullet *bullet = nullptr;
+        int steps = 0;
+        for (qint64 i = 0; i < n; ++i) {
+            if (!bullet || steps == 60) {
+                delete bullet;
+                bullet = new Bullet(&scene, 0, 1, 150, 110, 100, 10, 0);
+                steps = 0;
+            }
+            bullet->move();
+            ++steps;
+            if ((i & 1023) == 1023)
+                scene.clearTimers();
+        }
+        delete bullet;
+        scene.clearTimers();
+    });
+}
+
+static void benchAnimate(BenchRunner &runner)
+{
+    QGraphicsScene scene;
+    QGraphicsPixmapItem *item = scene.addPixmap(gImageCache->load("interface/SunBack.png"));
+    runner.run("Animate::chain", [&](qint64 n) {
+        for (qint64 i = 0; i < n; ++i) {
+            Animate(item, &scene).move(QPointF(i % 100, 0)).speed(1).replace().finish()
+                    .move(QPointF(0, 0)).scale(0.5).speed(1).finish();
+        }
+    });
+}
+
+static void benchMoviePixmapItem(BenchRunner &runner)
+{
+    MoviePixmapItem item;
+    runner.run("MoviePixmapItem::setMovie", [&](qint64 n) {
+        for (qint64 i = 0; i < n; ++i)
+            item.setMovie((i & 1) ? "Zombies/Zombie/Zombie.gif" : "Zombies/Zombie/ZombieAttack.gif");
+    });
+}
+
+// 测试期间屏蔽调试输出（出怪等函数会打印大量日志，影响计时）
+static void quietMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+{
+    if (type == QtDebugMsg || type == QtInfoMsg)
+        return;
+    QTextStream(stderr) << qFormatLogMessage(type, context, msg) << endl;
+}
+
+int main(int argc, char * *argv)
+{
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName("pvz-bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Plants vs Zombies microbenchmarks");
+    parser.addHelpOption();
+    QCommandLineOption outputOption("output", "Write JSON results to <file> instead of stdout.", "file");
+    QCommandLineOption filterOption("filter", "Only run benchmarks whose name contains <text>.", "text");
+    QCommandLineOption minTimeOption("min-time", "Minimum measured time per benchmark in milliseconds.", "ms", "200");
+    parser.addOption(outputOption);
+    parser.addOption(filterOption);
+    QCommandLineOption jobsOption("jobs", "Worker threads for the parallel monitorTick (default 0: single-threaded).",
+                                  "threads", "0");
+    parser.addOption(minTimeOption);
+    parser.addOption(jobsOption);
+    parser.process(app);
+
+    qInstallMessageHandler(quietMessageHandler);
+    InitImageManager();
+    qsrand(0);  // 固定随机数种子，保证每次运行的工作量一致
+    InitJobSystem(parser.value(jobsOption).toInt());
+
+    // GameScene 依赖 gMainView
+    MainWindow mainWindow;
+
+    BenchRunner runner(parser.value(filterOption), qMax(1, parser.value(minTimeOption).toInt()));
+    benchCoordinate(runner);
+    benchImageManager(runner);
+    benchMonitorTick(runner, 50, 5);
+    benchMonitorTick(runner, 200, 25);
+    benchMonitorTick(runner, 1000, 25);
+    benchSelectFlagZombie(runner);
+    benchBulletMove(runner);
+    benchAnimate(runner);
+    benchMoviePixmapItem(runner);
+
+    QJsonObject root;
+    root["qt_version"] = QString(qVersion());
+    root["min_time_ms"] = parser.value(minTimeOption).toInt();
+    root["jobs"] = gJobSystem ? gJobSystem->threadCount() : 0;
+    root["benchmarks"] = runner.results;
+    QByteArray json = QJsonDocument(root).toJson();
+
+    int res = 0;
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (file.open(QIODevice::WriteOnly))
+            file.write(json);
+        else {
+            QTextStream(stderr) << "Cannot write " << file.fileName() << endl;
+            res = 1;
+        }
+    }
+    else
+        QTextStream(stdout) << json;
+
+    DestroyJobSystem();
+    DestoryImageManager();
+    return res;
+}
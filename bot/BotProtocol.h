@@ -0,0 +1,87 @@
+#ifndef PLANTS_VS_ZOMBIES_BOTPROTOCOL_H
+#define PLANTS_VS_ZOMBIES_BOTPROTOCOL_H
+
+#include <QtGlobal>
+
+/*
+ * 外部机器人与 pvz-bot-server 之间的协议（均为本机字节序）
+ *
+ * 请求经 QLocalSocket 发送：1 字节命令，后跟该命令的定长参数
+ *   BotReset   quint32 seed            以种子重新开始一局
+ *   BotStep    quint32 ticks           推进若干轮监控（每轮 100ms 游戏时间），游戏结束后不再推进
+ *   BotPlace   quint8 card, col, row   使用第 card 张卡片种植（规则与玩家点击相同）
+ *   BotShovel  quint8 col, row         铲除格子最上层的植物
+ *   BotCollect                         收集场上全部阳光（服务以 --manual-sun 启动时才有作用）
+ * 每个请求回复一个 BotReply。回复之前观测已写入共享内存，直到下一个请求之前保持不变，
+ * 可与回复中的 sequence 对照确认
+ */
+
+enum BotCommand : quint8 {
+    BotReset = 1,
+    BotStep = 2,
+    BotPlace = 3,
+    BotShovel = 4,
+    BotCollect = 5
+};
+
+enum BotGameState : qint32 {
+    BotRunning = 0,
+    BotWon = 1,
+    BotLost = 2,
+    BotNoGame = 3     // 尚未 BotReset
+};
+
+struct BotReply {
+    qint32 ok;          // 命令是否生效（如阳光不足、格子不可种时为 0）
+    qint32 state;       // BotGameState
+    quint32 sequence;   // 与 BotObservation::sequence 相同
+};
+
+/**
+ * @brief 写入共享内存的观测，行、列从 0 开始（对应游戏中的第1行、第1列）
+ */
+struct BotObservation {
+    enum { Magic = 0x4f5a5650 /* "PVZO" */, Version = 2,
+           MaxRows = 6, MaxCols = 9, MaxZombiesPerRow = 32, MaxCards = 10 };
+
+    struct Cell {
+        quint8 plant;       // 最上层植物的卡片序号 + 1，0 为空，255 为不在卡片中的植物
+        quint8 layers;      // 格子中植物的数量（如南瓜头套住的植物）
+        quint16 hp;         // 最上层植物的生命值
+    };
+
+    struct Zombie {
+        float x;            // 横坐标（场景坐标，越小越靠近房子）
+        qint16 hp;
+        quint8 type;        // 关卡僵尸列表中的序号 + 1
+        quint8 flags;       // ZombieFrozen | ZombieAttacking
+    };
+    enum { ZombieFrozen = 1, ZombieAttacking = 2 };
+
+    struct Card {
+        quint8 plant;       // 卡片序号 + 1
+        quint8 ready;       // 冷却完成且阳光足够
+        quint16 sunCost;
+        qint32 cooldown;    // 剩余冷却时间（毫秒）
+        quint64 placeable;  // 可种植的格子，第 row * 9 + col 位为第 row 行第 col 列（用于屏蔽无效动作）
+    };
+
+    quint32 magic, version, sequence;
+    qint32 state;           // BotGameState
+    qint32 time;            // 本局游戏时间（毫秒）
+    qint32 sun, wave;
+    qint32 rowCount, colCount, cardCount;
+    Cell grid[MaxRows][MaxCols];
+    quint8 zombieCount[MaxRows];    // 每行的僵尸数（最多 MaxZombiesPerRow 个，按 x 从小到大）
+    quint8 reserved[2];
+    Zombie zombies[MaxRows][MaxZombiesPerRow];
+    Card cards[MaxCards];
+};
+
+Q_STATIC_ASSERT(sizeof(BotReply) == 12);
+Q_STATIC_ASSERT(sizeof(BotObservation::Cell) == 4);
+Q_STATIC_ASSERT(sizeof(BotObservation::Zombie) == 8);
+Q_STATIC_ASSERT(sizeof(BotObservation::Card) == 16);
+Q_STATIC_ASSERT(sizeof(BotObservation) == 40 + 4 * 6 * 9 + 8 + 8 * 6 * 32 + 16 * 10);
+
+#endif //PLANTS_VS_ZOMBIES_BOTPROTOCOL_H
@@ -0,0 +1,264 @@
+// 机器人本地服务的实现文件：命令解析、对局的创建与推进、观测写入共享内存
+
+#include <algorithm>
+#include <cstring>
+#include "BotServer.h"
+#include "GameScene.h"
+#include "GameLevelData.h"
+#include "GameClock.h"
+#include "Plant.h"
+#include "Zombie.h"
+
+// 各命令参数的字节数，-1 表示未知命令
+static int argumentSize(quint8 command)
+{
+    switch (command) {
+        case BotReset:
+        case BotStep:
+            return 4;
+        case BotPlace:
+            return 3;
+        case BotShovel:
+            return 2;
+        case BotCollect:
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+BotServer::BotServer(const QString &level, const QStringList &cards, bool autoCollectSun)
+        : level(level), cards(cards), autoCollectSun(autoCollectSun), scene(nullptr), state(BotNoGame), sequence(0)
+{
+    QObject::connect(&server, &QLocalServer::newConnection, [this] {
+        while (QLocalSocket *socket = server.nextPendingConnection()) {
+            QObject::connect(socket, &QLocalSocket::readyRead, [this, socket] { readCommands(socket); });
+            QObject::connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        }
+    });
+}
+
+BotServer::~BotServer()
+{
+    destroyGame();
+}
+
+bool BotServer::listen(const QString &name)
+{
+    memory.setKey(name + "-observation");
+    if (!memory.create(sizeof(BotObservation))) {
+        // Unix 下进程异常退出后共享内存可能残留：先附加再分离以释放，然后重新创建
+        if (memory.error() != QSharedMemory::AlreadyExists || !memory.attach() || !memory.detach()
+                || !memory.create(sizeof(BotObservation))) {
+            error = memory.errorString();
+            return false;
+        }
+    }
+    memset(memory.data(), 0, memory.size());
+    writeObservation();
+
+    QLocalServer::removeServer(name);
+    if (!server.listen(name)) {
+        error = server.errorString();
+        return false;
+    }
+    return true;
+}
+
+QString BotServer::errorString() const
+{
+    return error;
+}
+
+QString BotServer::observationKey() const
+{
+    return memory.key();
+}
+
+QString BotServer::observationNativeKey() const
+{
+    return memory.nativeKey();
+}
+
+// 一次读入缓冲区中所有完整的命令，全部执行后统一发送回复
+void BotServer::readCommands(QLocalSocket *socket)
+{
+    QByteArray replies;
+    while (socket->bytesAvailable() > 0) {
+        char command;
+        socket->peek(&command, 1);
+        int size = argumentSize(quint8(command));
+        if (size < 0) {
+            qWarning() << "Bot client sent unknown command" << int(quint8(command)) << ", disconnecting";
+            socket->abort();
+            return;
+        }
+        if (socket->bytesAvailable() < 1 + size)
+            break;
+        QByteArray request = socket->read(1 + size);
+        BotReply reply = execute(quint8(request[0]), request.constData() + 1);
+        replies.append(reinterpret_cast<const char *>(&reply), sizeof(reply));
+    }
+    if (!replies.isEmpty())
+        socket->write(replies);
+}
+
+// 读取 4 字节的参数，只用于参数长度为 4 的命令（BotReset、BotStep），其余命令的参数更短
+static quint32 readValue(const char *args)
+{
+    quint32 value;
+    memcpy(&value, args, sizeof(value));
+    return value;
+}
+
+BotReply BotServer::execute(quint8 command, const char *args)
+{
+    const quint8 *bytes = reinterpret_cast<const quint8 *>(args);
+
+    bool ok = false;
+    if (command == BotReset)
+        ok = reset(readValue(args));
+    else if (scene && state == BotRunning) {
+        switch (command) {
+            case BotStep:
+                step(int(qMin(readValue(args), quint32(INT_MAX))));
+                ok = true;
+                break;
+            case BotPlace:
+                ok = scene->plantCard(bytes[0], bytes[1] + 1, bytes[2] + 1);
+                break;
+            case BotShovel:
+                ok = scene->shovelPlant(bytes[0] + 1, bytes[1] + 1);
+                break;
+            case BotCollect:
+                scene->collectSuns();
+                ok = true;
+                break;
+        }
+    }
+    writeObservation();
+    return { ok, state, sequence };
+}
+
+bool BotServer::reset(quint32 seed)
+{
+    destroyGame();
+
+    GameLevelData *gameLevelData = GameLevelDataFactory(level);
+    if (!gameLevelData)
+        return false;
+    InitGameClock();
+    qsrand(seed);
+    gameLevelData->showScroll = false;
+    gameLevelData->canSelectCard = false;
+    gameLevelData->pName = cards;
+    gameLevelData->maxSelectedCards = cards.size();
+    zombieTypes = gameLevelData->zName;
+
+    scene = new GameScene(gameLevelData);
+    scene->setAutoCollectSun(autoCollectSun);
+    state = BotRunning;
+    QObject::connect(scene, &GameScene::gameFinished, [this](bool won) {
+        state = won ? BotWon : BotLost;
+    });
+    return true;
+}
+
+void BotServer::step(int ticks)
+{
+    static const int TickInterval = 100;
+    for (int i = 0; i < ticks && state == BotRunning; ++i) {
+        gGameClock->advanceTo(gGameClock->now() + TickInterval);
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+}
+
+void BotServer::destroyGame()
+{
+    if (scene) {
+        delete scene;
+        scene = nullptr;
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+    DestroyGameClock();
+    state = BotNoGame;
+}
+
+void BotServer::writeObservation()
+{
+    BotObservation *observation = static_cast<BotObservation *>(memory.data());
+    ++sequence;
+    observation->magic = BotObservation::Magic;
+    observation->version = BotObservation::Version;
+    observation->state = state;
+    if (!scene) {
+        observation->time = observation->sun = observation->wave = 0;
+        observation->rowCount = observation->colCount = observation->cardCount = 0;
+        observation->sequence = sequence;
+        return;
+    }
+
+    Coordinate &coordinate = scene->getCoordinate();
+    int rowCount = qMin(coordinate.rowCount(), int(BotObservation::MaxRows));
+    int colCount = qMin(coordinate.colCount(), int(BotObservation::MaxCols));
+    const QList<Plant *> &selectedPlants = scene->getSelectedPlants();
+    int cardCount = qMin(selectedPlants.size(), int(BotObservation::MaxCards));
+
+    observation->time = int(gGameClock->now());
+    observation->sun = scene->getSunNum();
+    observation->wave = scene->getWaveNum();
+    observation->rowCount = rowCount;
+    observation->colCount = colCount;
+    observation->cardCount = cardCount;
+
+    for (int row = 0; row < rowCount; ++row) {
+        for (int col = 0; col < colCount; ++col) {
+            BotObservation::Cell &cell = observation->grid[row][col];
+            QMap<int, PlantInstance *> plants = scene->getPlant(col + 1, row + 1);
+            if (plants.isEmpty()) {
+                cell = { 0, 0, 0 };
+                continue;
+            }
+            PlantInstance *top = plants.last();
+            int card = selectedPlants.indexOf(const_cast<Plant *>(top->plantProtoType));
+            cell.plant = quint8(card >= 0 && card < cardCount ? card + 1 : 255);
+            cell.layers = quint8(plants.size());
+            cell.hp = quint16(qBound(0, top->hp, 65535));
+        }
+    }
+
+    for (int row = 0; row < rowCount; ++row) {
+        QList<ZombieInstance *> zombies;
+        for (ZombieInstance *zombie: scene->getZombieOnRow(row + 1))
+            if (zombie->hp > 0)
+                zombies.push_back(zombie);
+        std::sort(zombies.begin(), zombies.end(), [](ZombieInstance *a, ZombieInstance *b) { return a->ZX < b->ZX; });
+
+        int count = qMin(zombies.size(), int(BotObservation::MaxZombiesPerRow));
+        observation->zombieCount[row] = quint8(count);
+        for (int i = 0; i < count; ++i) {
+            ZombieInstance *zombie = zombies[i];
+            observation->zombies[row][i] = {
+                float(zombie->ZX),
+                qint16(qBound(-32768, zombie->hp, 32767)),
+                quint8(zombieTypes.indexOf(zombie->zombieProtoType->eName) + 1),
+                quint8((zombie->statusEffects.has(StatusEffects::Slow) ? BotObservation::ZombieFrozen : 0)
+                       | (zombie->isAttacking ? BotObservation::ZombieAttacking : 0))
+            };
+        }
+    }
+
+    for (int i = 0; i < cardCount; ++i) {
+        int cooldown = scene->getCardCooldown(i);
+        observation->cards[i] = {
+            quint8(i + 1),
+            quint8(cooldown == 0 && selectedPlants[i]->sunNum <= scene->getSunNum()),
+            quint16(selectedPlants[i]->sunNum),
+            cooldown,
+            scene->getPlacementMask(selectedPlants[i])
+        };
+    }
+
+    // 序号最后写入，客户端据此判断观测已完整
+    observation->sequence = sequence;
+}
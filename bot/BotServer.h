@@ -0,0 +1,55 @@
+#ifndef PLANTS_VS_ZOMBIES_BOTSERVER_H
+#define PLANTS_VS_ZOMBIES_BOTSERVER_H
+
+#include <QtCore>
+#include <QtNetwork>
+#include "BotProtocol.h"
+
+class GameScene;
+
+/**
+ * @brief 供外部机器人逐步驱动游戏的本地服务
+ *
+ * 通过 QLocalServer 接收 BotProtocol.h 中的命令，游戏在虚拟时钟下运行（只在 BotStep 时推进），
+ * 每条命令执行后把观测直接写入共享内存，回复中只携带结果与序号。同一时间只有一局游戏，
+ * 多个连接的命令按到达顺序作用于这一局
+ */
+class BotServer
+{
+public:
+    // autoCollectSun 为 true 时阳光产出即计入（BotCollect 不再有作用），否则阳光留在场上等待收集
+    BotServer(const QString &level, const QStringList &cards, bool autoCollectSun);
+    ~BotServer();
+
+    // 开始监听并创建共享内存，失败时返回 false，原因见 errorString
+    bool listen(const QString &name);
+    QString errorString() const;
+
+    // 观测所在共享内存的键（Qt 客户端用 QSharedMemory::setKey，其他客户端用 nativeKey）
+    QString observationKey() const;
+    QString observationNativeKey() const;
+
+private:
+    void readCommands(QLocalSocket *socket);
+    BotReply execute(quint8 command, const char *args);
+
+    bool reset(quint32 seed);
+    void step(int ticks);
+    void destroyGame();
+    void writeObservation();
+
+    QString level;
+    QStringList cards;
+    QStringList zombieTypes;    // 关卡的僵尸列表，用于观测中的僵尸类型
+    bool autoCollectSun;
+
+    QLocalServer server;
+    QSharedMemory memory;
+    QString error;
+
+    GameScene *scene;
+    qint32 state;               // BotGameState
+    quint32 sequence;
+};
+
+#endif //PLANTS_VS_ZOMBIES_BOTSERVER_H
@@ -0,0 +1,75 @@
+// 机器人本地服务程序：在虚拟时钟下运行一局游戏，由外部进程通过本地套接字逐步驱动
+// 用法：pvz-bot-server [--name pvz-bot] [--level 1] [--cards oSunflower,oPeashooter,oWallNut] [--manual-sun]
+
+#include <QtCore>
+#include <QtWidgets>
+#include "MainView.h"
+#include "GameLevelData.h"
+#include "ImageManager.h"
+#include "AudioManager.h"
+#include "BotServer.h"
+
+// 屏蔽游戏中的调试输出
+static void quietMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+{
+    if (type == QtDebugMsg || type == QtInfoMsg)
+        return;
+    QTextStream(stderr) << qFormatLogMessage(type, context, msg) << endl;
+}
+
+int main(int argc, char * *argv)
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName("pvz-bot-server");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Plants vs Zombies stepping server for external bots (see BotProtocol.h)");
+    parser.addHelpOption();
+    QCommandLineOption nameOption("name", "Local server name; observations go to shared memory <name>-observation.",
+                                  "name", "pvz-bot");
+    QCommandLineOption levelOption("level", "Level to play (default 1).", "name", "1");
+    QCommandLineOption cardsOption("cards", "Comma-separated card selection.", "cards", "oSunflower,oPeashooter,oWallNut");
+    QCommandLineOption manualSunOption("manual-sun", "Leave suns on the field until BotCollect (default: collect automatically).");
+    parser.addOptions({ nameOption, levelOption, cardsOption, manualSunOption });
+    parser.process(app);
+
+    QString level = parser.value(levelOption);
+    QStringList cards = parser.value(cardsOption).split(',', QString::SkipEmptyParts);
+    GameLevelData *gameLevelData = GameLevelDataFactory(level);
+    if (!gameLevelData) {
+        QTextStream(stderr) << "Unknown level " << level << endl;
+        return 1;
+    }
+    bool valid = cards.size() <= BotObservation::MaxCards;
+    for (const QString &card: cards)
+        valid = valid && gameLevelData->pName.contains(card);
+    delete gameLevelData;
+    if (!valid) {
+        QTextStream(stderr) << "Cards must be at most " << int(BotObservation::MaxCards)
+                            << " plants available in level " << level << endl;
+        return 1;
+    }
+
+    qInstallMessageHandler(quietMessageHandler);
+    AudioManager::setMuted(true);
+    InitImageManager();
+    int res;
+    {
+        MainWindow mainWindow;  // GameScene 依赖 gMainView
+        BotServer server(level, cards, !parser.isSet(manualSunOption));
+        if (!server.listen(parser.value(nameOption))) {
+            QTextStream(stderr) << "Cannot start bot server: " << server.errorString() << endl;
+            DestoryImageManager();
+            return 1;
+        }
+        QTextStream(stdout) << "Listening on " << parser.value(nameOption)
+                            << ", observation shared memory " << server.observationKey()
+                            << " (native key " << server.observationNativeKey() << ", "
+                            << sizeof(BotObservation) << " bytes)" << endl;
+        res = app.exec();
+    }
+    DestoryImageManager();
+    return res;
+}
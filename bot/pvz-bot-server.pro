@@ -0,0 +1,17 @@
+QT += widgets multimedia network
+
+CONFIG += console
+CONFIG -= app_bundle
+
+QMAKE_CXXFLAGS += -Wno-unused-parameter
+
+
+include(../src/src.pri)
+HEADERS += BotProtocol.h BotServer.h
+SOURCES += main.cpp BotServer.cpp
+RESOURCES += ../main.qrc
+
+TARGET = pvz-bot-server
+
+OBJECTS_DIR = out/obj
+MOC_DIR = out/moc
@@ -0,0 +1,368 @@
+// 关卡平衡的批量评估工具：在虚拟时钟下按脚本化的种植策略跑完大量带种子的对局，
+// 由多个工作进程分担以利用全部核心，汇总胜率、割草机使用次数、剩余阳光与到达的波次
+// 用法：pvz-eval --level 1 --cards oSunflower,oPeashooter,oWallNut --runs 2000 [--jobs 8] [--output runs.csv]
+
+#include <QtCore>
+#include <QtWidgets>
+#include "MainView.h"
+#include "GameScene.h"
+#include "GameLevelData.h"
+#include "GameClock.h"
+#include "ImageManager.h"
+#include "AudioManager.h"
+#include "Plant.h"
+#include "Zombie.h"
+
+struct EvalConfig
+{
+    QString level;
+    QStringList cards;
+    int producerCols;     // 种向日葵的列数（从第1列起）
+    int maxTime;          // 单局虚拟时间上限（毫秒），超过记为 timeout
+    uint seed;
+};
+
+struct RunResult
+{
+    int run;
+    uint seed;
+    QString result;       // win / lose / timeout
+    int lawnMowersUsed;
+    int finalSun;
+    int wave;
+    qint64 gameTime;      // 结束时的虚拟时间（毫秒）
+
+    QString toCsv() const
+    {
+        return QString("%1,%2,%3,%4,%5,%6,%7").arg(run).arg(seed).arg(result)
+                .arg(lawnMowersUsed).arg(finalSun).arg(wave).arg(gameTime);
+    }
+};
+
+static const char *RunCsvHeader = "run,seed,result,lawn_mowers_used,final_sun,wave,game_time_ms";
+
+/**
+ * @brief 脚本化的种植策略
+ *
+ * 阳光产出即自动收集，每次决策按卡片顺序尝试种植：
+ * 向日葵种在前 producerCols 列；射手类种在威胁最大（在场僵尸最多）的行中最靠左的空位；
+ * 坚果类只在有僵尸的行种在第8、9列；火爆辣椒、倭瓜在某行聚集至少3个僵尸时使用。
+ * 行的先后相同时用 qrand 决定，因此不同种子会走出不同的对局
+ */
+class PlacementPolicy
+{
+public:
+    PlacementPolicy(GameScene *scene, int producerCols)
+            : scene(scene), producerCols(producerCols)
+    {}
+
+    void step()
+    {
+        const QList<Plant *> &cards = scene->getSelectedPlants();
+        for (int i = 0; i < cards.size(); ++i) {
+            const QString &eName = cards[i]->eName;
+            if (eName == "oSunflower")
+                plantProducer(i);
+            else if (eName == "oWallNut" || eName == "oTallNut" || eName == "oPumpkinHead")
+                plantWall(i);
+            else if (eName == "oJalapeno" || eName == "oSquash")
+                plantInstant(i, eName == "oSquash");
+            else
+                plantDefender(i);
+        }
+    }
+
+private:
+    int rowCount() const
+    {
+        return scene->getCoordinate().rowCount();
+    }
+
+    // 行内已进入草坪的存活僵尸数
+    int threat(int row) const
+    {
+        int count = 0;
+        for (ZombieInstance *zombie: scene->getZombieOnRow(row))
+            if (zombie->hp > 0 && zombie->ZX <= 900)
+                ++count;
+        return count;
+    }
+
+    // 按威胁从大到小排列的行，威胁相同时随机
+    QList<int> rowsByThreat() const
+    {
+        QList<QPair<int, int> > keys;
+        for (int row = 1; row <= rowCount(); ++row)
+            keys.push_back(qMakePair(-threat(row) * 1024 - qrand() % 1024, row));
+        qSort(keys);
+        QList<int> rows;
+        for (const auto &key: keys)
+            rows.push_back(key.second);
+        return rows;
+    }
+
+    bool plantProducer(int index)
+    {
+        int first = 1 + qrand() % rowCount();
+        for (int col = 1; col <= producerCols; ++col)
+            for (int i = 0; i < rowCount(); ++i)
+                if (scene->plantCard(index, col, 1 + (first - 1 + i) % rowCount()))
+                    return true;
+        return false;
+    }
+
+    bool plantDefender(int index)
+    {
+        for (int row: rowsByThreat())
+            for (int col = producerCols + 1; col <= 7; ++col)
+                if (scene->plantCard(index, col, row))
+                    return true;
+        return false;
+    }
+
+    bool plantWall(int index)
+    {
+        for (int row: rowsByThreat()) {
+            if (!threat(row))
+                break;
+            if (scene->plantCard(index, 8, row) || scene->plantCard(index, 9, row))
+                return true;
+        }
+        return false;
+    }
+
+    bool plantInstant(int index, bool atFront)
+    {
+        int row = rowsByThreat().value(0);
+        if (!row || threat(row) < 3)
+            return false;
+        if (atFront) {
+            // 倭瓜放在最前面的僵尸所在列（或其左侧一列）
+            qreal front = 900;
+            for (ZombieInstance *zombie: scene->getZombieOnRow(row))
+                if (zombie->hp > 0)
+                    front = qMin(front, zombie->ZX);
+            int col = qBound(1, scene->getCoordinate().getCol(front), 9);
+            return scene->plantCard(index, col, row) || scene->plantCard(index, col - 1, row);
+        }
+        for (int col = 9; col >= 1; --col)
+            if (scene->plantCard(index, col, row))
+                return true;
+        return false;
+    }
+
+    GameScene *scene;
+    int producerCols;
+};
+
+// 在虚拟时钟下完整地跑一局
+static RunResult playGame(const EvalConfig &config, int run)
+{
+    static const int TickInterval = 100, DecisionInterval = 500;
+
+    InitGameClock();
+    uint seed = config.seed + uint(run);
+    qsrand(seed);
+
+    GameLevelData *level = GameLevelDataFactory(config.level);
+    level->showScroll = false;
+    level->canSelectCard = false;
+    level->pName = config.cards;
+    level->maxSelectedCards = config.cards.size();
+    int lawnMowers = level->LF.count(1);
+
+    GameScene *scene = new GameScene(level);
+    scene->setAutoCollectSun(true);  // 阳光产出即计入，不创建阳光图元
+    bool finished = false, won = false;
+    QObject::connect(scene, &GameScene::gameFinished, [&finished, &won](bool result) {
+        finished = true;
+        won = result;
+    });
+
+    PlacementPolicy policy(scene, config.producerCols);
+    while (!finished && gGameClock->now() < config.maxTime) {
+        gGameClock->advanceTo(gGameClock->now() + TickInterval);
+        if (!finished && gGameClock->now() % DecisionInterval == 0)
+            policy.step();
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    RunResult result = { run, seed, finished ? (won ? "win" : "lose") : "timeout",
+                         lawnMowers - scene->getPlantCount("oLawnCleaner"),
+                         scene->getSunNum(), scene->getWaveNum(), gGameClock->now() };
+    delete scene;
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    DestroyGameClock();
+    return result;
+}
+
+// 工作进程：依次跑 [first, first + count) 号对局，每局结束输出一行 CSV
+static int runWorker(const EvalConfig &config, int first, int count)
+{
+    AudioManager::setMuted(true);
+    InitImageManager();
+    MainWindow mainWindow;  // GameScene 依赖 gMainView
+
+    QTextStream out(stdout);
+    for (int run = first; run < first + count; ++run) {
+        out << playGame(config, run).toCsv() << endl;
+    }
+    DestoryImageManager();
+    return 0;
+}
+
+// 主进程：把对局平均分给各工作进程，收集结果并汇总
+// 各工作进程每局输出一行，运行期间随时读取，避免管道写满后工作进程阻塞在输出上
+static int runMaster(const EvalConfig &config, int runs, int jobs, const QString &outputFile, const QStringList &workerArgs)
+{
+    QList<QProcess *> workers;
+    QMap<int, QString> lines;
+    QHash<QProcess *, QByteArray> partial;  // 各工作进程尚未读到换行的输出
+    QEventLoop loop;
+    int failed = 0, running = 0;
+
+    // 取出已完整的行；工作进程结束时连同最后不带换行的部分一起取出
+    auto drain = [&lines, &partial](QProcess *worker, bool finished) {
+        QByteArray &buffer = partial[worker];
+        buffer += worker->readAllStandardOutput();
+        int end;
+        while ((end = buffer.indexOf('\n')) >= 0 || (finished && !buffer.isEmpty())) {
+            QString text = QString::fromUtf8(end >= 0 ? buffer.left(end) : buffer).trimmed();
+            buffer.remove(0, end >= 0 ? end + 1 : buffer.size());
+            if (!text.isEmpty())
+                lines.insert(text.section(',', 0, 0).toInt(), text);
+        }
+    };
+
+    int perWorker = (runs + jobs - 1) / jobs;
+    for (int first = 0; first < runs; first += perWorker) {
+        QProcess *worker = new QProcess;
+        workers.push_back(worker);
+        worker->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        QObject::connect(worker, &QProcess::readyReadStandardOutput, [worker, &drain] { drain(worker, false); });
+        QObject::connect(worker, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+                         [worker, &drain, &failed, &running, &loop](int exitCode, QProcess::ExitStatus exitStatus) {
+            drain(worker, true);
+            if (exitStatus != QProcess::NormalExit || exitCode != 0)
+                ++failed;
+            if (--running == 0)
+                loop.quit();
+        });
+        ++running;
+        worker->start(QCoreApplication::applicationFilePath(), QStringList(workerArgs)
+                << "--worker" << "--first" << QString::number(first)
+                << "--count" << QString::number(qMin(perWorker, runs - first)));
+        if (!worker->waitForStarted(-1)) {
+            QTextStream(stderr) << "Cannot start worker: " << worker->errorString() << endl;
+            --running;
+            ++failed;
+        }
+    }
+    if (running)
+        loop.exec();
+    qDeleteAll(workers);
+    if (failed)
+        QTextStream(stderr) << failed << " worker(s) failed" << endl;
+
+    if (!outputFile.isEmpty()) {
+        QFile file(outputFile);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            QTextStream(stderr) << "Cannot write " << outputFile << endl;
+            return 1;
+        }
+        QTextStream csv(&file);
+        csv << RunCsvHeader << "\n";
+        for (const QString &line: lines)
+            csv << line << "\n";
+    }
+
+    // 汇总
+    int wins = 0, timeouts = 0, mowers = 0, sun = 0, waves = 0, maxWave = 0;
+    for (const QString &line: lines) {
+        QStringList fields = line.split(',');
+        wins += fields[2] == "win";
+        timeouts += fields[2] == "timeout";
+        mowers += fields[3].toInt();
+        sun += fields[4].toInt();
+        waves += fields[5].toInt();
+        maxWave = qMax(maxWave, fields[5].toInt());
+    }
+    int n = qMax(1, lines.size());
+    QTextStream out(stdout);
+    out << "level,cards,runs,wins,win_rate,timeouts,avg_lawn_mowers_used,avg_final_sun,avg_wave,max_wave\n";
+    out << QString("%1,%2,%3,%4,%5,%6,%7,%8,%9,%10\n").arg(config.level).arg(config.cards.join(' '))
+            .arg(lines.size()).arg(wins).arg(double(wins) / n, 0, 'f', 4).arg(timeouts)
+            .arg(double(mowers) / n, 0, 'f', 3).arg(double(sun) / n, 0, 'f', 1)
+            .arg(double(waves) / n, 0, 'f', 2).arg(maxWave);
+    return failed || lines.size() != runs ? 1 : 0;
+}
+
+// 评估期间屏蔽调试输出（出怪等函数会打印大量日志）
+static void quietMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+{
+    if (type == QtDebugMsg || type == QtInfoMsg || type == QtWarningMsg)
+        return;
+    QTextStream(stderr) << qFormatLogMessage(type, context, msg) << endl;
+}
+
+int main(int argc, char * *argv)
+{
+    // 无需显示窗口，默认使用 offscreen 平台（工作进程继承该环境变量）
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName("pvz-eval");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Plants vs Zombies batch loadout evaluator");
+    parser.addHelpOption();
+    QCommandLineOption levelOption("level", "Level to play (default 1).", "name", "1");
+    QCommandLineOption cardsOption("cards", "Comma-separated card selection, e.g. oSunflower,oPeashooter,oWallNut.",
+                                   "cards", "oSunflower,oPeashooter,oWallNut");
+    QCommandLineOption runsOption("runs", "Number of games (default 1000).", "n", "1000");
+    QCommandLineOption seedOption("seed", "Seed of the first game; game i uses seed + i (default 1).", "seed", "1");
+    QCommandLineOption jobsOption("jobs", "Worker processes (default: number of cores).", "n",
+                                  QString::number(QThread::idealThreadCount()));
+    QCommandLineOption producerColsOption("producer-cols", "Columns filled with sunflowers (default 1).", "n", "1");
+    QCommandLineOption maxTimeOption("max-time", "Game time limit in seconds (default 1800).", "s", "1800");
+    QCommandLineOption outputOption("output", "Also write per-game results as CSV to <file>.", "file");
+    QCommandLineOption workerOption("worker", "Internal: run games [first, first + count) and print CSV lines.");
+    QCommandLineOption firstOption("first", "Internal: first game index.", "n", "0");
+    QCommandLineOption countOption("count", "Internal: number of games.", "n", "0");
+    parser.addOptions({ levelOption, cardsOption, runsOption, seedOption, jobsOption, producerColsOption,
+                        maxTimeOption, outputOption, workerOption, firstOption, countOption });
+    parser.process(app);
+
+    EvalConfig config;
+    config.level = parser.value(levelOption);
+    config.cards = parser.value(cardsOption).split(',', QString::SkipEmptyParts);
+    config.producerCols = qMax(0, parser.value(producerColsOption).toInt());
+    config.maxTime = qMax(1, parser.value(maxTimeOption).toInt()) * 1000;
+    config.seed = parser.value(seedOption).toUInt();
+
+    GameLevelData *level = GameLevelDataFactory(config.level);
+    if (!level) {
+        QTextStream(stderr) << "Unknown level " << config.level << endl;
+        return 1;
+    }
+    for (const QString &card: config.cards) {
+        if (!level->pName.contains(card)) {
+            QTextStream(stderr) << "Card " << card << " is not available in level " << config.level << endl;
+            delete level;
+            return 1;
+        }
+    }
+    delete level;
+
+    qInstallMessageHandler(quietMessageHandler);
+    if (parser.isSet(workerOption))
+        return runWorker(config, parser.value(firstOption).toInt(), parser.value(countOption).toInt());
+
+    // 工作进程使用与主进程相同的配置
+    QStringList workerArgs = { "--level", config.level, "--cards", config.cards.join(','),
+                               "--seed", QString::number(config.seed),
+                               "--producer-cols", QString::number(config.producerCols),
+                               "--max-time", QString::number(config.maxTime / 1000) };
+    return runMaster(config, qMax(1, parser.value(runsOption).toInt()), qMax(1, parser.value(jobsOption).toInt()),
+                     parser.value(outputOption), workerArgs);
+}
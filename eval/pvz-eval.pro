@@ -0,0 +1,16 @@
+QT += widgets multimedia
+
+CONFIG += console
+CONFIG -= app_bundle
+
+QMAKE_CXXFLAGS += -Wno-unused-parameter
+
+
+include(../src/src.pri)
+SOURCES += main.cpp
+RESOURCES += ../main.qrc
+
+TARGET = pvz-eval
+
+OBJECTS_DIR = out/obj
+MOC_DIR = out/moc
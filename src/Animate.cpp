@@ -73,50 +73,36 @@ Animate &Animate::finish(std::function<void(void)> functor)
 // 设置动画结束时的处理函数，带布尔参数
 Animate &Animate::finish(std::function<void(bool)> functor)
 {
-    Animation *animation = getAnimation(item);
+    TweenEngine *engine = TweenEngine::of(scene);
     if (!(type & (MOVE | SCALE | FADE))) {
-        if (animation) {
-            animation->anim->stop();
-            delete animation->anim;
-            for (auto &keyFrame: animation->frames)
-                keyFrame.finished(false);
-            delete animation;
-            setAnimation(item, nullptr);
-        }
+        for (auto &keyFrame: engine->cancel(item))
+            keyFrame.finished(false);
     }
-    else if (animation && !(type & REPLACE))
-        animation->frames.push_back({ type, m_duration, m_speed, toPos, toScale, toOpacity, functor, m_shape});
+    else if (engine->contains(item) && !(type & REPLACE))
+        engine->append(item, { type, m_duration, m_speed, toPos, toScale, toOpacity, functor, m_shape });
     else {
-        if (animation) {
-            animation->anim->stop();
-            delete animation->anim;
-            for (auto &keyFrame: animation->frames)
-                keyFrame.finished(false);
-            if (!(type & MOVE))
-                for (auto &keyFrame: animation->frames)
-                    if (keyFrame.type & MOVE) {
-                        type |= MOVE;
-                        toPos = keyFrame.toPos;
-                    }
-            if (!(type & SCALE))
-                for (auto &keyFrame: animation->frames)
-                    if (keyFrame.type & SCALE) {
-                        type |= SCALE;
-                        toScale = keyFrame.toScale;
-                    }
-            if (!(type & FADE))
-                for (auto &keyFrame: animation->frames)
-                    if (keyFrame.type & FADE) {
-                        type |= FADE;
-                        toOpacity = keyFrame.toOpacity;
-                    }
-            delete animation;
-        }
-        animation = new Animation;
-        animation->scene = scene;
-        animation->frames.push_back({type, m_duration, m_speed, toPos, toScale, toOpacity, functor, m_shape});
-        setAnimation(item, animation);
-        generateAnimation(item);
+        QList<TweenEngine::KeyFrame> frames = engine->cancel(item);
+        for (auto &keyFrame: frames)
+            keyFrame.finished(false);
+        if (!(type & MOVE))
+            for (auto &keyFrame: frames)
+                if (keyFrame.type & MOVE) {
+                    type |= MOVE;
+                    toPos = keyFrame.toPos;
+                }
+        if (!(type & SCALE))
+            for (auto &keyFrame: frames)
+                if (keyFrame.type & SCALE) {
+                    type |= SCALE;
+                    toScale = keyFrame.toScale;
+                }
+        if (!(type & FADE))
+            for (auto &keyFrame: frames)
+                if (keyFrame.type & FADE) {
+                    type |= FADE;
+                    toOpacity = keyFrame.toOpacity;
+                }
+        engine->append(item, { type & ~REPLACE, m_duration, m_speed, toPos, toScale, toOpacity, functor, m_shape });
     }
 
     type = 0;
@@ -127,77 +113,3 @@ Animate &Animate::finish(std::function<void(bool)> functor)
     m_shape = QTimeLine::EaseInOutCurve;
     return *this;
 }
-
-// 获取图形项的动画对象
-Animate::Animation *Animate::getAnimation(QGraphicsItem *item)
-{
-    if (!item->data(AnimationKey).isNull()) {
-        auto prevAnim = static_cast<Animation *>(item->data(AnimationKey).value<void *>());
-        return prevAnim;
-    }
-    return nullptr;
-}
-
-// 设置图形项的动画对象
-void Animate::setAnimation(QGraphicsItem *item, Animate::Animation *animation)
-{
-    item->setData(AnimationKey, QVariant::fromValue(static_cast<void *>(animation)));
-}
-
-// 生成动画
-void Animate::generateAnimation(QGraphicsItem *item)
-{
-    Animation *animation = getAnimation(item);
-    KeyFrame &keyFrame = animation->frames.first();
-    QPointF fromPos = item->pos(), toPos = keyFrame.toPos;
-    qreal fromScale = item->scale(), toScale = keyFrame.toScale,
-            fromOpacity = item->opacity(), toOpacity = keyFrame.toOpacity;
-    bool move = static_cast<bool>(keyFrame.type & MOVE),
-            scale = static_cast<bool>(keyFrame.type & SCALE),
-            fade = static_cast<bool>(keyFrame.type & FADE);
-    if (!keyFrame.duration) {
-        QPointF posVec = toPos - fromPos;
-        keyFrame.duration = qRound(qSqrt(QPointF::dotProduct(posVec, posVec)) / keyFrame.speed);
-    }
-
-    if (keyFrame.duration <= 0) {
-        animation->frames.first().finished(true);
-        animation->frames.pop_front();
-        if (!animation->frames.isEmpty()) {
-            generateAnimation(item);
-        }
-        else {
-            delete animation;
-            setAnimation(item, nullptr);
-        }
-    }
-    else {
-        animation->anim = new QTimeLine(keyFrame.duration, animation->scene);
-        animation->anim->setUpdateInterval(20);
-        animation->anim->setCurveShape(keyFrame.shape);
-        QObject::connect(animation->anim, &QTimeLine::valueChanged, [item, fromPos, toPos, fromScale, toScale, fromOpacity, toOpacity, move, scale, fade](qreal x) {
-            if (move)
-                item->setPos((toPos - fromPos) * x + fromPos);
-            if (scale)
-                item->setScale((toScale - fromScale) * x + fromScale);
-            if (fade)
-                item->setOpacity((toOpacity - fromOpacity) * x + fromOpacity);
-        });
-        QObject::connect(animation->anim, &QTimeLine::finished, [item, animation] {
-            animation->frames.first().finished(true);
-            animation->frames.pop_front();
-            if (!animation->frames.isEmpty()) {
-                generateAnimation(item);
-            }
-            else {
-                delete animation->anim;
-                delete animation;
-                setAnimation(item, nullptr);
-            }
-        });
-        animation->anim->start();
-    }
-}
-
-// 动画对象的键值
-const int Animate::AnimationKey = 0;
@@ -2,8 +2,9 @@
 #define PLANTS_VS_ZOMBIES_BASESCENE_H
 
 #include <QtWidgets>
+#include "TweenEngine.h"
 
-// 动画控制类，用于创建和管理图形项的动画效果
+// 动画控制类，用于创建和管理图形项的动画效果（关键帧由场景的 TweenEngine 统一推进）
 class Animate
 {
 public:
@@ -34,43 +35,15 @@ public:
     Animate &finish(std::function<void(bool)> functor = [](bool) {});
 
 protected:
-    // 动画关键帧类型枚举(使用位掩码)
+    // 动画关键帧类型枚举(使用位掩码，与 TweenEngine::KeyFrameType 一致)
     enum KeyFrameType {
-        MOVE = 0x01,    // 移动动画
-        SCALE = 0x02,   // 缩放动画
-        FADE = 0x04,    // 透明度动画
+        MOVE = TweenEngine::MOVE,       // 移动动画
+        SCALE = TweenEngine::SCALE,     // 缩放动画
+        FADE = TweenEngine::FADE,       // 透明度动画
         REPLACE = 0x08  // 替换动画
     };
 
-    // 关键帧结构体，保存单次动画的参数
-    struct KeyFrame {
-        int type;               // 动画类型(KeyFrameType的组合)
-        int duration;           // 持续时间(毫秒)
-        qreal speed;            // 动画速度(当duration=0时使用)
-        QPointF toPos;          // 目标位置
-        qreal toScale;          // 目标缩放比例
-        qreal toOpacity;        // 目标透明度
-        std::function<void(bool)> finished; // 完成回调
-        QTimeLine::CurveShape shape; // 动画曲线形状
-    };
-
-    // 动画结构体，保存一个完整的动画序列
-    struct Animation {
-        QTimeLine *anim;        // Qt动画时间线对象
-        QGraphicsScene *scene;   // 所属场景
-        QList<KeyFrame> frames;  // 关键帧列表
-    };
-
-    // 静态方法，获取图形项关联的动画对象
-    static Animation *getAnimation(QGraphicsItem *item);
-    // 静态方法，设置图形项的动画对象
-    static void setAnimation(QGraphicsItem *item, Animation *animation);
-    // 静态方法，生成并执行动画
-    static void generateAnimation(QGraphicsItem *item);
-
 private:
-    static const int AnimationKey; // 用于在图形项中存储动画的键值
-
     // 当前动画参数
     int type;                   // 动画类型
     int m_duration;             // 持续时间
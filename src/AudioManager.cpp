@@ -2,4 +2,29 @@
 // Created by sun on 9/9/16.
 //
 
+#include <QtMultimedia>
 #include "AudioManager.h"
+#include "PerfMonitor.h"
+#include "TraceRecorder.h"
+
+bool AudioManager::muted = false;
+
+// 播放一段短音效
+void AudioManager::play(const QString &filename)
+{
+    if (muted)
+        return;
+    PerfScope scope(PerfMonitor::Audio);
+    TRACE_SCOPE_DETAIL("audio", "AudioManager::play", filename);
+    QSound::play(filename);
+}
+
+void AudioManager::setMuted(bool muted)
+{
+    AudioManager::muted = muted;
+}
+
+bool AudioManager::isMuted()
+{
+    return muted;
+}
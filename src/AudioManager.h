@@ -5,11 +5,20 @@
 #ifndef PLANTS_VS_ZOMBIES_AUDIOMANAGER_H
 #define PLANTS_VS_ZOMBIES_AUDIOMANAGER_H
 
+#include <QtCore>
 
+// 音效播放入口，所有短音效都经由这里播放，便于统一统计与控制
 class AudioManager
 {
 public:
-//    void playAudio(const );
+    static void play(const QString &filename);
+
+    // 静音时不播放任何音效与关卡背景音乐（用于无界面的批量评估）
+    static void setMuted(bool muted);
+    static bool isMuted();
+
+private:
+    static bool muted;
 };
 
 
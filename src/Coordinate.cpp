@@ -1,58 +1,82 @@
 // 坐标类的实现文件，负责处理游戏中的坐标转换和行列计算等操作
 
 #include "Coordinate.h"
+#include <cmath>
 
-// 坐标类构造函数，初始化坐标映射表
-Coordinate::Coordinate(int coord) : col(9)
-{
-    x2c = QPair<QList<double>, QList<int> >(
-            { -50, 100, 140, 220, 295, 379, 460, 540, 625, 695, 775, 855, 935 },
-            {  -2,  -1,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11 });
-    c2x = QPair<QList<int>, QList<double> >(
-            {  -2,  -1,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11 },
-            { -50, 100, 140, 187, 267, 347, 427, 507, 587, 667, 747, 827, 865, 950 });
-    if (coord == 0) {
-        row = 5;
-        y2r = QPair<QList<double>, QList<int> >(
+// 白天草坪与泳池共用的列坐标
+static constexpr CoordinateAxis DayCols = makeCoordinateAxis(-2,
+        { -50, 100, 140, 220, 295, 379, 460, 540, 625, 695, 775, 855, 935 },
+        { -50, 100, 140, 187, 267, 347, 427, 507, 587, 667, 747, 827, 865, 950 });
+
+static constexpr CoordinateLayout LawnLayout = {
+        DayCols,
+        makeCoordinateAxis(0,
                 {  86, 181, 281, 386, 476 },
-                {   0,   1,   2,   3,   4,   5 });
-        r2y = QPair<QList<int>, QList<double> >(
-                {   0,   1,   2,   3,   4,   5 },
-                {  75, 175, 270, 380, 470, 575 });
-    }
-    else { // Pool
-        row = 6;
-        y2r = QPair<QList<double>, QList<int> >(
+                {  75, 175, 270, 380, 470, 575 }),
+        9, 5
+};
+
+static constexpr CoordinateLayout PoolLayout = {
+        DayCols,
+        makeCoordinateAxis(0,
                 {  86, 171, 264, 368, 440, 532 },
-                {   0,   1,   2,   3,   4,   5,  6 });
-        r2y = QPair<QList<int>, QList<double> >(
-                {   0,   1,   2,   3,   4,   5,   6 },
-                {  75, 165, 253, 355, 430, 552, 587 });
-    }
+                {  75, 165, 253, 355, 430, 552, 587 }),
+        9, 6
+};
+
+static_assert(DayCols.valid && LawnLayout.rows.valid && PoolLayout.rows.valid, "invalid coordinate layout");
+
+// 布局表，按布局编号排列；浓雾关卡沿用泳池的格子。
+// 屋顶的行坐标随列倾斜，需要为每列另建一张行查找表，届时在 CoordinateLayout 中扩展
+static const CoordinateLayout *const layouts[Coordinate::LayoutCount] = {
+        &LawnLayout,    // Lawn
+        &PoolLayout,    // Pool
+        &PoolLayout,    // Fog
+};
+
+// 像素坐标所在的格号：分界都是整数，v 落在 (k-1, k] 内时与像素 k 的结果相同
+int CoordinateAxis::cell(double v) const
+{
+    if (!(v > origin))
+        return first;
+    if (v > origin + span - 1)
+        return last;
+    return cells[int(std::ceil(v)) - origin];
 }
 
+// 格号的中心坐标，超出范围的格号取最近的一格
+double CoordinateAxis::center(int c) const
+{
+    return centers[qBound(first, c, last) - first];
+}
+
+// 坐标类构造函数，选取布局编号对应的静态查找表
+Coordinate::Coordinate(int coord)
+        : layout(coord >= 0 && coord < LayoutCount ? layouts[coord] : &PoolLayout)
+{}
+
 // 根据 X 坐标获取列号
 int Coordinate::getCol(double x) const
 {
-    return x2c.second[qLowerBound(x2c.first, x) - x2c.first.begin()];
+    return layout->cols.cell(x);
 }
 
 // 根据 Y 坐标获取行号
 int Coordinate::getRow(double y) const
 {
-    return y2r.second[qLowerBound(y2r.first, y) - y2r.first.begin()];
+    return layout->rows.cell(y);
 }
 
 // 根据列号获取 X 坐标
 double Coordinate::getX(int c) const
 {
-    return c2x.second[qBinaryFind(c2x.first, c) - c2x.first.begin()];
+    return layout->cols.center(c);
 }
 
 // 根据行号获取 Y 坐标
 double Coordinate::getY(int r) const
 {
-    return r2y.second[qBinaryFind(r2y.first, r) - r2y.first.begin()];
+    return layout->rows.center(r);
 }
 
 // 选择植物的 X 坐标和列号
@@ -82,11 +106,11 @@ int truncBetween(int value, int low, int high)
 // 获取行数
 int Coordinate::rowCount() const
 {
-    return row;
+    return layout->rowCount;
 }
 
 // 获取列数
 int Coordinate::colCount() const
 {
-    return col;
+    return layout->colCount;
 }
@@ -2,6 +2,7 @@
 #define PLANTS_VS_ZOMBIES_COORDINATE_H
 
 #include <QtCore>  // 包含Qt核心模块
+#include <initializer_list>
 
 /**
  * @brief 数值截断函数
@@ -12,6 +13,61 @@
  */
 int truncBetween(int value, int low, int high);
 
+/**
+ * @brief 一个方向（列或行）上的坐标查找表
+ *
+ * 由升序的整数分界像素与各格的中心坐标在编译期生成：像素坐标 v 满足 v <= bounds[i] 的最小 i 决定格号
+ * first + i（大于所有分界时为 last），查表时只需一次取整与下标访问
+ */
+struct CoordinateAxis
+{
+    enum { MaxSpan = 1024, MaxCells = 16 };
+
+    int first, last;                 // 格号范围
+    int origin, span;                // 查找表覆盖的像素范围 [origin, origin + span)
+    signed char cells[MaxSpan];      // 像素 origin + i 所在的格号
+    double centers[MaxCells];        // 格号 first + i 的中心坐标
+    bool valid;                      // 分界与中心数量匹配且未超出表的容量
+
+    int cell(double v) const;
+    double center(int c) const;
+};
+
+// 在编译期生成查找表；bounds 为升序分界，centers 比 bounds 多一项（依次对应 first..last）
+constexpr CoordinateAxis makeCoordinateAxis(int first, std::initializer_list<int> bounds,
+                                            std::initializer_list<double> centers)
+{
+    CoordinateAxis axis{};
+    axis.first = first;
+    axis.last = first + int(bounds.size());
+    axis.origin = *bounds.begin();
+    axis.span = *(bounds.end() - 1) - axis.origin + 1;
+    axis.valid = centers.size() == bounds.size() + 1 && centers.size() <= CoordinateAxis::MaxCells
+                 && axis.span > 0 && axis.span <= CoordinateAxis::MaxSpan;
+    if (!axis.valid)
+        return axis;
+    for (int i = 0; i < axis.span; ++i) {
+        int below = 0;  // 小于该像素的分界个数，即 qLowerBound 的位置
+        for (int bound: bounds)
+            if (bound < axis.origin + i)
+                ++below;
+        axis.cells[i] = static_cast<signed char>(first + below);
+    }
+    int i = 0;
+    for (double center: centers)
+        axis.centers[i++] = center;
+    return axis;
+}
+
+/**
+ * @brief 草坪布局描述：列、行两个方向的查找表与可种植的行列数
+ */
+struct CoordinateLayout
+{
+    CoordinateAxis cols, rows;
+    int colCount, rowCount;
+};
+
 /**
  * @brief 游戏坐标转换类
  *
@@ -22,9 +78,12 @@ int truncBetween(int value, int low, int high);
 class Coordinate
 {
 public:
+    // 布局编号（即关卡数据中的 coord）；新增布局时在 Coordinate.cpp 的布局表中追加一项
+    enum Layout { Lawn = 0, Pool = 1, Fog = 2, LayoutCount };
+
     /**
      * @brief 构造函数
-     * @param coord 初始化坐标值，默认为0
+     * @param coord 布局编号，默认为草坪；未知编号按泳池布局处理
      */
     explicit Coordinate(int coord = 0);
 
@@ -43,14 +102,7 @@ public:
     int colCount() const;   // 获取总列数
 
 private:
-    // 私有成员
-    int row, col;  // 当前行列坐标
-
-    // 坐标映射系统（使用QPair存储双向映射）
-    QPair<QList<double>, QList<int>> x2c;  // X坐标到列号的映射
-    QPair<QList<double>, QList<int>> y2r;  // Y坐标到行号的映射
-    QPair<QList<int>, QList<double>> c2x;  // 列号到X坐标的映射
-    QPair<QList<int>, QList<double>> r2y;  // 行号到Y坐标的映射
+    const CoordinateLayout *layout;  // 指向静态的布局描述，复制 Coordinate 不复制查找表
 };
 
 #endif //PLANTS_VS_ZOMBIES_COORDINATE_H
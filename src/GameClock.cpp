@@ -0,0 +1,49 @@
+// 虚拟游戏时钟的实现文件
+
+#include "GameClock.h"
+
+GameClock *gGameClock = nullptr;
+
+GameClock::GameClock()
+        : current(0), sequence(0)
+{}
+
+qint64 GameClock::now() const
+{
+    return current;
+}
+
+void GameClock::schedule(int delay, QObject *context, std::function<void(void)> functor)
+{
+    events.insert(std::make_pair(qMakePair(current + qMax(0, delay), sequence++), Event{ context, functor }));
+}
+
+void GameClock::advanceTo(qint64 time)
+{
+    while (!events.empty() && events.begin()->first.first <= time) {
+        auto first = events.begin();
+        current = first->first.first;
+        Event event = first->second;
+        events.erase(first);
+        if (event.context)
+            event.functor();
+    }
+    current = qMax(current, time);
+}
+
+int GameClock::pendingCount() const
+{
+    return int(events.size());
+}
+
+void InitGameClock()
+{
+    if (!gGameClock)
+        gGameClock = new GameClock;
+}
+
+void DestroyGameClock()
+{
+    delete gGameClock;
+    gGameClock = nullptr;
+}
@@ -0,0 +1,48 @@
+#ifndef PLANTS_VS_ZOMBIES_GAMECLOCK_H
+#define PLANTS_VS_ZOMBIES_GAMECLOCK_H
+
+#include <QtCore>
+#include <functional>
+#include <map>
+
+/**
+ * @brief 虚拟游戏时钟
+ *
+ * 只在无界面的批量评估中存在（gGameClock 非空）。此时 Timer、TimeLine、Animate 与监控计时器
+ * 都不再使用真实的 Qt 计时器，而是向这里预约事件，由调用者通过 advanceTo 推进时间，
+ * 一局游戏可以远快于实时地跑完。同一时刻的事件按预约顺序执行，因此结果只取决于随机数种子
+ */
+class GameClock
+{
+public:
+    GameClock();
+
+    // 当前虚拟时间（毫秒）
+    qint64 now() const;
+
+    // 在 delay 毫秒后执行 functor；context 不能为空，被销毁后不再执行
+    void schedule(int delay, QObject *context, std::function<void(void)> functor);
+
+    // 依次执行到期时间不晚于 time 的事件（包括执行过程中新预约的），并把当前时间推进到 time
+    void advanceTo(qint64 time);
+
+    // 尚未执行的事件数
+    int pendingCount() const;
+
+private:
+    struct Event {
+        QPointer<QObject> context;
+        std::function<void(void)> functor;
+    };
+
+    qint64 current;
+    quint64 sequence;
+    std::map<QPair<qint64, quint64>, Event> events;  // (到期时间, 预约序号) -> 事件
+};
+
+extern GameClock *gGameClock;
+
+void InitGameClock();
+void DestroyGameClock();
+
+#endif //PLANTS_VS_ZOMBIES_GAMECLOCK_H
@@ -2,6 +2,7 @@
 #include <QtMultimedia>
 #include <stdlib.h>
 #include <math.h>
+#include <algorithm>
 #include "GameScene.h"
 #include "MainView.h"
 #include "ImageManager.h"
@@ -13,6 +14,15 @@
 #include "PlantCardItem.h"
 #include "Animate.h"
 #include "SelectorScene.h"
+#include "PerfMonitor.h"
+#include "PerfHud.h"
+#include "TraceRecorder.h"
+#include "ObjectCounter.h"
+#include "AudioManager.h"
+#include "JobSystem.h"
+#include "GameClock.h"
+#include "ProductionScheduler.h"
+#include "TweenEngine.h"
 
 GameScene::GameScene(GameLevelData *gameLevelData)
         : QGraphicsScene(0, 0, 900, 600),  // 场景尺寸：900x600像素
@@ -35,7 +45,7 @@ GameScene::GameScene(GameLevelData *gameLevelData)
           selectCardTextOkay(new QGraphicsSimpleTextItem(tr("Go"))),
           // 选卡面板与卡片组
           selectingPanel(new QGraphicsPixmapItem(gImageCache->load("interface/SeedChooser_Background.png"))),
-          cardPanel(new QGraphicsItemGroup),
+          cardPanel(new QGraphicsItemGroup), seedBank(nullptr),
           // 铲子与移动植物相关组件
           shovel(new QGraphicsPixmapItem(gImageCache->load("interface/Shovel.png"))),
           shovelBackground(new QGraphicsPixmapItem(gImageCache->load("interface/ShovelBack.png"))),
@@ -53,8 +63,29 @@ GameScene::GameScene(GameLevelData *gameLevelData)
           backgroundMusic(new QMediaPlayer(this)),
           coordinate(gameLevelData->coord),
           choose(0), sunNum(gameLevelData->sunNum),
-          waveTimer(nullptr), monitorTimer(new QTimer(this)), waveNum(0)
+          waveTimer(nullptr), monitorTimer(new QTimer(this)),
+          productionScheduler(new ProductionScheduler(this)), waveNum(0),
+          tickCount(0), renderTimer(new QTimer(this)),
+          renderArrival(-1), renderDuration(0), renderSettled(true),
+          previewZombiesStarted(false), autoCollectSun(false), perfHud(nullptr)
 {
+    OBJECT_COUNTER_INC("GameScene");
+    // 生产事件：向日葵等先发光再弹出阳光，天空阳光直接掉落
+    // 已死亡（等待回收）的植物在回收前仍登记着生产者，不再发光也不再产出
+    connect(productionScheduler, &ProductionScheduler::charging, [](int id, PlantInstance *source) {
+        if (source && !source->dead)
+            source->beginProduction();
+    });
+    connect(productionScheduler, &ProductionScheduler::produced, [this](int id, PlantInstance *source, int amount) {
+        if (source) {
+            if (source->dead)
+                return;
+            source->endProduction();
+            growSun(source, amount);
+        }
+        else
+            dropSun(amount);
+    });
     // 注册植物原型（通过工厂模式创建实例）
     for (const auto &eName: gameLevelData->pName)
         plantProtoTypes.insert(eName, PlantFactory(this, eName));
@@ -82,14 +113,10 @@ GameScene::GameScene(GameLevelData *gameLevelData)
         // 排序Y坐标并随机打乱僵尸顺序
         qSort(yPos.begin(), yPos.end());
         std::random_shuffle(zombies.begin(), zombies.end());
-        // 创建僵尸动画并添加到背景
-        for (int i = 0; i < zombies.size(); ++i) {
-            MoviePixmapItem *pixmap = new MoviePixmapItem(zombies[i]->standGif);
-            QSizeF size = pixmap->boundingRect().size();
-            // 右侧随机位置显示预览
-            pixmap->setPos(qFloor(1115 + qrand() % 200) - size.width() * 0.5, yPos[i] - size.width() * 0.5);
-            pixmap->setParentItem(background);
-        }
+        // 记录僵尸动画及其右侧随机位置，之后分帧创建并添加到背景，避免进入关卡时卡住一帧
+        for (int i = 0; i < zombies.size(); ++i)
+            pendingPreviewZombies.push_back(qMakePair(zombies[i]->standGif, QPointF(qFloor(1115 + qrand() % 200), yPos[i])));
+        createPreviewZombies();
     }
     // 游戏组（包含植物、僵尸等动态对象，不处理子事件）
     gameGroup->setHandlesChildEvents(false);
@@ -117,8 +144,12 @@ GameScene::GameScene(GameLevelData *gameLevelData)
     addItem(menuGroup);
     // 点击事件：停止计时器、音乐，返回主菜单
     connect(menuGroup, &MouseEventPixmapItem::clicked, [this] {
-        monitorTimer->stop();
-        delete monitorTimer;
+        if (monitorTimer) {
+            monitorTimer->stop();
+            delete monitorTimer;
+            monitorTimer = nullptr;
+        }
+        renderTimer->stop();
         backgroundMusic->blockSignals(true);
         backgroundMusic->stop();
         backgroundMusic->blockSignals(false);
@@ -203,7 +234,7 @@ GameScene::GameScene(GameLevelData *gameLevelData)
             // 点击事件：选择卡片并添加到已选组
             connect(plantCardItem, &PlantCardItem::clicked, [this, item, plantCardItem] {
                 if (!plantCardItem->isChecked()) return;  // 未选中则跳过
-                QSound::play(":/audio/tap.wav");  // 播放点击音效
+                AudioManager::play(":/audio/tap.wav");  // 播放点击音效
                 int count = selectedPlantArray.size();
                 // 检查是否达到最大选卡数量
                 if (this->gameLevelData->maxSelectedCards > 0 && count >= this->gameLevelData->maxSelectedCards)
@@ -253,7 +284,7 @@ GameScene::GameScene(GameLevelData *gameLevelData)
                 };
                 // 连接反选事件与重置按钮事件
                 *deselectConnnection = connect(selectedPlantCardItem, &PlantCardItem::clicked, [this, selectedPlantCardItem, deselectFunctor] {
-                    QSound::play(":/audio/tap.wav");
+                    AudioManager::play(":/audio/tap.wav");
                     QList<QGraphicsItem *> selectedCards = cardPanel->childItems();
                     for (int i = qFind(selectedCards, selectedPlantCardItem) - selectedCards.begin() + 1; i != selectedCards.size(); ++i)
                         Animate(selectedCards[i], this).move(QPointF(0, 60 * (i - 1))).speed(1.5).replace().finish();
@@ -264,8 +295,8 @@ GameScene::GameScene(GameLevelData *gameLevelData)
             ++cardIndex;
         }
         // 连接确认/重置按钮的点击音效
-        connect(selectCardButtonOkay, &MouseEventPixmapItem::clicked, [this] { QSound::play(":/audio/tap.wav"); });
-        connect(selectCardButtonReset, &MouseEventPixmapItem::clicked, [this] { QSound::play(":/audio/tap.wav"); });
+        connect(selectCardButtonOkay, &MouseEventPixmapItem::clicked, [this] { AudioManager::play(":/audio/tap.wav"); });
+        connect(selectCardButtonReset, &MouseEventPixmapItem::clicked, [this] { AudioManager::play(":/audio/tap.wav"); });
         // 选卡面板初始隐藏在场景外（Y=-高度）
         selectingPanel->setPos(100, -selectingPanel->boundingRect().height());
         addItem(selectingPanel);
@@ -333,14 +364,24 @@ GameScene::GameScene(GameLevelData *gameLevelData)
     // 植物触发区域与僵尸行数据初始化
     for (int i = 0; i <= coordinate.rowCount(); ++i) {
         plantTriggers.push_back(QList<Trigger *>());  // 每行的植物触发区域列表
+        triggerEpochs.push_back(1);  // 僵尸的初始版本为0，首次检测时计算空闲区间
         zombieRow.push_back(QList<ZombieInstance *>());  // 每行的僵尸实例列表
     }
+    eatTargets.resize((coordinate.rowCount() + 1) * (coordinate.colCount() + 1));
 
     loadReady();  // 加载完成，触发场景准备事件
 }
 
 GameScene::~GameScene()
 {
+    OBJECT_COUNTER_DEC("GameScene");
+    // 释放游戏实例内存（场景中的实际对象，析构时图片放回对象池，需要原型仍然存在）
+    reclaimDead();
+    for (auto i: plantInstances)
+        delete i;
+    for (auto i: zombieInstances)
+        delete i;
+
     // 释放植物触发区域内存
     for (int i = 0; i < coordinate.rowCount(); ++i) {
         for (auto item: plantTriggers[i])
@@ -353,14 +394,16 @@ GameScene::~GameScene()
     for (auto i: zombieProtoTypes.values())
         delete i;
 
-    // 释放游戏实例内存（场景中的实际对象）
-    for (auto i: plantInstances)
-        delete i;
-    for (auto i: zombieInstances)
-        delete i;
+    // 对象池中的图片已移出场景，需要单独释放
+    qDeleteAll(picturePool);
+    qDeleteAll(bulletPicturePool);
 
     // 释放关卡数据内存
     delete gameLevelData;
+
+    // 性能面板随场景一起销毁，同时关闭统计
+    if (perfHud)
+        DestroyPerfMonitor();
 }
 
 void GameScene::setInfoText(const QString &text)
@@ -392,6 +435,9 @@ void GameScene::loadReady()
 
 void GameScene::loadAcessFinished()
 {
+    // 片头滚动期间在后台解码本关卡的图片，开局后不再同步加载
+    gImageCache->prefetch(levelImages());
+
     // 自动选择植物卡片（当禁用选卡或无滚动条时）
     if (!gameLevelData->showScroll || !gameLevelData->canSelectCard) {
         for (auto item: plantProtoTypes.values()) {
@@ -417,6 +463,7 @@ void GameScene::loadAcessFinished()
             setInfoText("");  // 隐藏欢迎信息
 
             // 启动背景中预览僵尸的动画
+            previewZombiesStarted = true;
             for (auto zombie: background->childItems())
                 static_cast<MoviePixmapItem *>(zombie)->start();
 
@@ -428,6 +475,7 @@ void GameScene::loadAcessFinished()
                 // 背景回滚并开始游戏的函数
                 auto scrollBack = [this] {
                     Animate(background, this).move(QPointF(-115, 0)).speed(0.5).finish([this] {
+                        pendingPreviewZombies.clear();
                         for (auto zombie: background->childItems())
                             delete zombie;  // 删除预览僵尸
                         letsGo();  // 开始游戏主循环
@@ -487,6 +535,46 @@ GameLevelData *GameScene::getGameLevelData() const
     return gameLevelData;  // 返回当前场景关联的关卡数据
 }
 
+QStringList GameScene::levelImages() const
+{
+    QStringList paths;
+    for (const Plant *plant: plantProtoTypes)
+        paths << plant->cardGif << plant->staticGif;
+    for (const Zombie *zombie: zombieProtoTypes)
+        paths << zombie->staticGif;
+    // 子弹与击中效果
+    for (int type = -1; type <= 2; ++type)
+        for (int direction = 0; direction <= 1; ++direction)
+            paths << QString("Plants/PB%1%2.gif").arg(type).arg(direction);
+    paths << "Plants/PeaBulletHit.gif"
+          << "interface/plantShadow.png"
+          << "interface/PrepareGrowPlants.png"
+          << "interface/ZombiesWon.png"
+          << "interface/trophy.png"
+          << "interface/FlagMeterEmpty.png" << "interface/FlagMeterFull.png"
+          << "interface/FlagMeterLevelProgress.png"
+          << "interface/FlagMeterParts1.png" << "interface/FlagMeterParts2.png";
+    paths.removeDuplicates();
+    return paths;
+}
+
+// 每帧创建少量预览僵尸（每个都要解码一张动图），直到全部创建完毕
+void GameScene::createPreviewZombies()
+{
+    TRACE_SCOPE("scene", "GameScene::createPreviewZombies");
+    for (int i = 0; i < 2 && !pendingPreviewZombies.isEmpty(); ++i) {
+        QPair<QString, QPointF> zombie = pendingPreviewZombies.takeFirst();
+        MoviePixmapItem *pixmap = new MoviePixmapItem(zombie.first);
+        QSizeF size = pixmap->boundingRect().size();
+        pixmap->setPos(zombie.second.x() - size.width() * 0.5, zombie.second.y() - size.width() * 0.5);
+        pixmap->setParentItem(background);
+        if (previewZombiesStarted)
+            pixmap->start();
+    }
+    if (!pendingPreviewZombies.isEmpty())
+        (new Timer(this, 16, [this] { createPreviewZombies(); }))->start();
+}
+
 void GameScene::letsGo()
 {
     // 阳光数值显示框从顶部滑入
@@ -508,16 +596,27 @@ void GameScene::letsGo()
     for (auto i: cardPanel->childItems())
         delete i;
 
-    // 生成已选植物卡片
-    for (int i = 0; i < selectedPlantArray.size(); ++i) {
-        auto &item = selectedPlantArray[i];  // 当前植物原型
+    // 生成卡片栏
+    seedBank = new SeedBankItem(selectedPlantArray);
+    cardPanel->addToGroup(seedBank);
 
-        // 创建植物卡片项
-        PlantCardItem *plantCardItem = new PlantCardItem(item);
-        plantCardItem->setChecked(false);
-        cardPanel->addToGroup(plantCardItem);
-        plantCardItem->setPos(0, i * 60);  // 垂直排列卡片
+    // 鼠标悬停事件（显示/移动提示框）
+    connect(seedBank, &SeedBankItem::hoverEntered, [this](int index, QGraphicsSceneHoverEvent *event) {
+        if (choose) return;  // 正在选择植物时不响应
+        cardTooltips[index]->setPos(event->scenePos() + QPointF(5, 15));
+        cardTooltips[index]->setVisible(true);
+    });
+    connect(seedBank, &SeedBankItem::hoverMoved, [this](int index, QGraphicsSceneHoverEvent *event) {
+        if (choose) return;
+        cardTooltips[index]->setPos(event->scenePos() + QPointF(5, 15));
+    });
+    connect(seedBank, &SeedBankItem::hoverLeft, [this](int index, QGraphicsSceneHoverEvent *event) {
+        if (choose) return;
+        cardTooltips[index]->setPos(event->scenePos() + QPointF(5, 15));
+        cardTooltips[index]->setVisible(false);
+    });
 
+    for (int i = 0; i < selectedPlantArray.size(); ++i) {
         // 创建卡片提示框
         TooltipItem *tooltipItem = new TooltipItem("");
         tooltipItem->setVisible(false);
@@ -525,25 +624,8 @@ void GameScene::letsGo()
         tooltipItem->setZValue(1);  // 提示框层级
         addItem(tooltipItem);
 
-        // 鼠标悬停事件（显示/移动提示框）
-        connect(plantCardItem, &PlantCardItem::hoverEntered, [this, tooltipItem](QGraphicsSceneHoverEvent *event) {
-            if (choose) return;  // 正在选择植物时不响应
-            tooltipItem->setPos(event->scenePos() + QPointF(5, 15));
-            tooltipItem->setVisible(true);
-        });
-        connect(plantCardItem, &PlantCardItem::hoverMoved, [this, tooltipItem](QGraphicsSceneHoverEvent *event) {
-            if (choose) return;
-            tooltipItem->setPos(event->scenePos() + QPointF(5, 15));
-        });
-        connect(plantCardItem, &PlantCardItem::hoverLeft, [this, tooltipItem](QGraphicsSceneHoverEvent *event) {
-            if (choose) return;
-            tooltipItem->setPos(event->scenePos() + QPointF(5, 15));
-            tooltipItem->setVisible(false);
-        });
-
-        // 存储卡片与提示框引用
-        cardGraphics.push_back({ plantCardItem, tooltipItem });
-        cardReady.push_back({ false, false });  // 初始化卡片状态（冷却/阳光）
+        cardTooltips.push_back(tooltipItem);
+        cardReady.push_back({ false, false, 0 });  // 初始化卡片状态（冷却/阳光）
         updateTooltip(i);  // 更新提示框内容
     }
 
@@ -551,20 +633,17 @@ void GameScene::letsGo()
     connect(this, &GameScene::mousePress, [this](QGraphicsSceneMouseEvent *event) {
         if (choose) return;  // 正在选择中时不响应新点击
 
-        int i;
-        // 遍历已选卡片，检查鼠标是否点击在卡片上
-        for (i = 0; i < selectedPlantArray.size(); ++i) {
-            if (cardReady[i].cool && cardReady[i].sun &&  // 卡片冷却完成且阳光足够
-                cardGraphics[i].plantCard->contains(event->scenePos() - cardGraphics[i].plantCard->scenePos()))
-                break;
-        }
+        // 检查鼠标是否点击在冷却完成且阳光足够的卡片上
+        int i = seedBank->cardAt(event->scenePos());
+        if (i < 0 || !cardReady[i].cool || !cardReady[i].sun)
+            i = selectedPlantArray.size();
 
         Plant *item = nullptr;  // 选中的植物原型
         QPointF delta;  // 位置偏移量
 
         // 情况1：点击了植物卡片
         if (i != selectedPlantArray.size()) {
-            cardGraphics[i].tooltip->setVisible(false);  // 隐藏提示框
+            cardTooltips[i]->setVisible(false);  // 隐藏提示框
             item = selectedPlantArray[i];
             QPixmap staticGif = gImageCache->load(item->staticGif);  // 加载植物静态图片
             // 计算拖拽时植物图片的偏移（居中显示）
@@ -575,7 +654,7 @@ void GameScene::letsGo()
             movePlant->setPixmap(staticGif);
             movePlant->setPos(event->scenePos() + delta);  // 跟随鼠标位置
             movePlant->setVisible(true);  // 显示植物图片
-            QSound::play(":/audio/seedlift.wav");  // 播放拾取音效
+            AudioManager::play(":/audio/seedlift.wav");  // 播放拾取音效
             choose = 1;  // 设置选择状态为"选择植物"
         }
         // 情况2：点击了铲子工具
@@ -585,7 +664,7 @@ void GameScene::letsGo()
             shovel->setCursor(Qt::ArrowCursor);  // 鼠标样式改为箭头
             shovelBackground->setCursor(Qt::ArrowCursor);
             shovel->setPos(event->scenePos() - shovelBackground->scenePos() + delta);  // 跟随鼠标位置
-            QSound::play(":/audio/shovel.wav");  // 播放铲子音效
+            AudioManager::play(":/audio/shovel.wav");  // 播放铲子音效
             choose = 2;  // 设置选择状态为"选择铲子"
         }
         else return;  // 其他情况不处理
@@ -600,7 +679,7 @@ void GameScene::letsGo()
                 movePlant->setPos(e->scenePos() + delta);  // 植物跟随鼠标
                 // 计算植物可种植的格子坐标
                 auto xPair = coordinate.choosePlantX(e->scenePos().x()), yPair = coordinate.choosePlantY(e->scenePos().y());
-                if (item->canGrow(xPair.second, yPair.second)) {  // 检查是否可种植
+                if (canPlace(item, xPair.second, yPair.second)) {  // 检查是否可种植
                     movePlantAlpha->setVisible(true);  // 显示半透明遮罩
                     // 遮罩定位到格子中心
                     movePlantAlpha->setPos(xPair.first + item->getDX(), yPair.first + item->getDY(xPair.second, yPair.second) - item->height);
@@ -637,53 +716,12 @@ void GameScene::letsGo()
                 movePlantAlpha->setVisible(false);  // 隐藏半透明遮罩
                 // 计算植物格子坐标
                 auto xPair = coordinate.choosePlantX(e->scenePos().x()), yPair = coordinate.choosePlantY(e->scenePos().y());
-                if (e->button() == Qt::LeftButton && item->canGrow(xPair.second, yPair.second)) {  // 左键且可种植
+                if (e->button() == Qt::LeftButton && canPlace(item, xPair.second, yPair.second)) {  // 左键且可种植
                     movePlant->setVisible(false);  // 隐藏移动植物图片
-
-                    // 播放生长动画（土壤或喷水）
-                    MoviePixmapItem *growGif;
-                    if (gameLevelData->LF[yPair.second] == 1)
-                        growGif = imgGrowSoil;
-                    else
-                        growGif = imgGrowSpray;
-                    growGif->setPos(xPair.first - 30, yPair.first - 30);  // 动画定位到格子中心
-                    growGif->setVisible(true);
-                    growGif->start();  // 播放动画
-                    // 动画结束后隐藏并重置
-                    QSharedPointer<QMetaObject::Connection> connection(new QMetaObject::Connection);
-                    *connection = connect(growGif, &MoviePixmapItem::finished, [growGif, connection]{
-                        growGif->setVisible(false);
-                        growGif->reset();
-                        disconnect(*connection.data());
-                    });
-
-                    // 处理植物位置冲突（替换同位置同类型植物）
-                    auto key = qMakePair(xPair.second, yPair.second);
-                    if (plantPosition.contains(key) && plantPosition[key].contains(item->pKind))
-                        plantDie(plantPosition[key][item->pKind]);  // 移除原有植物
-
-                    // 创建植物实例并添加到场景
-                    PlantInstance *plantInstance = PlantInstanceFactory(item);
-                    plantInstance->birth(xPair.second, yPair.second);  // 初始化植物位置
-                    plantInstances.push_back(plantInstance);
-                    if (!plantPosition.contains(key))
-                        plantPosition.insert(key, QMap<int, PlantInstance *>());
-                    plantPosition[key].insert(item->pKind, plantInstance);  // 记录植物位置
-                    plantUuid.insert(plantInstance->uuid, plantInstance);  // 记录植物UUID
-
-                    // 重置卡片冷却时间
-                    doCoolTime(i);
-                    // 扣除阳光并更新显示
-                    sunNum -= item->sunNum;
-                    updateSunNum();
-                    // 播放种植音效
-                    if (qrand() % 2)
-                        QSound::play(":/audio/plant1.wav");
-                    else
-                        QSound::play(":/audio/plant2.wav");
+                    growPlant(i, xPair.second, yPair.second);
                 } else {  // 不可种植时返回卡片位置
-                    QSound::play(":/audio/tap.wav");
-                    Animate(movePlant, this).move(cardGraphics[i].plantCard->scenePos() + QPointF(10, 0)).speed(1.5).finish([this] {
+                    AudioManager::play(":/audio/tap.wav");
+                    Animate(movePlant, this).move(seedBank->cardScenePos(i) + QPointF(10, 0)).speed(1.5).finish([this] {
                         movePlant->setVisible(false);
                     });
                 }
@@ -702,9 +740,9 @@ void GameScene::letsGo()
                 PlantInstance *plant;
                 if (e->button() == Qt::LeftButton && (plant = getPlant(e->scenePos()))) {
                     plantDie(plant);  // 调用植物死亡逻辑
-                    QSound::play(":/audio/plant2.wav");  // 播放铲除音效
+                    AudioManager::play(":/audio/plant2.wav");  // 播放铲除音效
                 } else {
-                    QSound::play(":/audio/tap.wav");  // 播放点击音效
+                    AudioManager::play(":/audio/tap.wav");  // 播放点击音效
                 }
             }
             choose = 0;  // 重置选择状态
@@ -715,19 +753,120 @@ void GameScene::letsGo()
     gameLevelData->startGame(this);
 }
 
+// 种下第 index 张卡片的植物：播放生长动画、替换同格同类植物、重置冷却并扣除阳光
+void GameScene::growPlant(int index, int col, int row)
+{
+    Plant *item = selectedPlantArray[index];
+
+    // 播放生长动画（土壤或喷水）
+    MoviePixmapItem *growGif;
+    if (gameLevelData->LF[row] == 1)
+        growGif = imgGrowSoil;
+    else
+        growGif = imgGrowSpray;
+    growGif->setPos(coordinate.getX(col) - 30, coordinate.getY(row) - 30);  // 动画定位到格子中心
+    growGif->setVisible(true);
+    growGif->start();  // 播放动画
+    // 动画结束后隐藏并重置
+    QSharedPointer<QMetaObject::Connection> connection(new QMetaObject::Connection);
+    *connection = connect(growGif, &MoviePixmapItem::finished, [growGif, connection]{
+        growGif->setVisible(false);
+        growGif->reset();
+        disconnect(*connection.data());
+    });
+
+    // 处理植物位置冲突（替换同位置同类型植物）
+    auto key = qMakePair(col, row);
+    if (plantPosition.contains(key) && plantPosition[key].contains(item->pKind))
+        plantDie(plantPosition[key][item->pKind]);  // 移除原有植物
+
+    // 创建植物实例并添加到场景
+    PlantInstance *plantInstance = PlantInstanceFactory(item);
+    plantInstance->birth(col, row);  // 初始化植物位置
+    plantInstance->instanceIndex = plantInstances.size();
+    plantInstances.push_back(plantInstance);
+    if (!plantPosition.contains(key))
+        plantPosition.insert(key, QMap<int, PlantInstance *>());
+    plantPosition[key].insert(item->pKind, plantInstance);  // 记录植物位置
+    plantUuid.insert(plantInstance->uuid, plantInstance);  // 记录植物UUID
+    updateCell(col, row);
+
+    // 重置卡片冷却时间
+    doCoolTime(index);
+    // 扣除阳光并更新显示
+    sunNum -= item->sunNum;
+    updateSunNum();
+    // 播放种植音效
+    if (qrand() % 2)
+        AudioManager::play(":/audio/plant1.wav");
+    else
+        AudioManager::play(":/audio/plant2.wav");
+}
+
+bool GameScene::plantCard(int index, int col, int row)
+{
+    if (!monitorTimer || choose || index < 0 || index >= selectedPlantArray.size())
+        return false;
+    if (!canPlantCard(index, col, row))
+        return false;
+    growPlant(index, col, row);
+    return true;
+}
+
+bool GameScene::canPlantCard(int index, int col, int row)
+{
+    return cardReady[index].cool && cardReady[index].sun && canPlace(selectedPlantArray[index], col, row);
+}
+
+void GameScene::collectSuns()
+{
+    for (MoviePixmapItem *sunGif: suns.keys())
+        collectSun(sunGif);
+}
+
+// 铲除格子中 pKind 最大（最上层）的植物，割草机所在的第0列不可铲除
+bool GameScene::shovelPlant(int col, int row)
+{
+    if (!monitorTimer || choose || !gameLevelData->hasShovel || col < 1)
+        return false;
+    auto iter = plantPosition.find(qMakePair(col, row));
+    if (iter == plantPosition.end() || iter->isEmpty())
+        return false;
+    plantDie(iter->last());
+    AudioManager::play(":/audio/plant2.wav");
+    return true;
+}
+
+// 当前时刻（毫秒）：有虚拟时钟时取虚拟时间，否则取单调时钟（不受修改系统时间影响）
+static qint64 gameTime()
+{
+    if (gGameClock)
+        return gGameClock->now();
+    static QElapsedTimer clock;
+    if (!clock.isValid())
+        clock.start();
+    return clock.elapsed();
+}
+
+int GameScene::getCardCooldown(int index) const
+{
+    if (cardReady[index].cool)
+        return 0;
+    return int(qMax(Q_INT64_C(0), cardReady[index].coolUntil - gameTime()));
+}
+
 void GameScene::beginCool()
 {
     for (int i = 0; i < selectedPlantArray.size(); ++i) {
         auto &item = selectedPlantArray[i];  // 当前植物原型
-        auto &plantCardItem = cardGraphics[i].plantCard;  // 当前卡片UI
 
         // 处理冷却时间小于7.6秒的植物（直接激活）
         if (item->coolTime < 7.6) {
-            plantCardItem->setPercent(1.0);  // 冷却进度100%
+            seedBank->setPercent(i, 1.0);  // 冷却进度100%
             cardReady[i].cool = true;  // 冷却完成
             if (item->sunNum <= sunNum) {  // 阳光足够
                 cardReady[i].sun = true;  // 阳光条件满足
-                plantCardItem->setChecked(true);  // 卡片激活
+                seedBank->setChecked(i, true);  // 卡片激活
             }
             updateTooltip(i);  // 更新提示框
             continue;
@@ -751,67 +890,113 @@ void GameScene::updateTooltip(int index)
     if (!cardReady[index].sun)
         text += "<br><span style=\"color:#f00\">" + tr("Not enough sun!") + "</span>";
 
-    cardGraphics[index].tooltip->setText(text);  // 更新提示框内容
+    cardTooltips[index]->setText(text);  // 更新提示框内容
 }
 
-QPair<MoviePixmapItem *, std::function<void(bool)> > GameScene::newSun(int sunNum)
+// 从对象池取出（没有时创建）一个阳光，登记为场上的阳光；阳光落地后由 sunLanded 开始计算存在时间
+MoviePixmapItem *GameScene::newSun(int sunNum)
 {
-    // 创建阳光动画对象
-    MoviePixmapItem *sunGif = new MoviePixmapItem("interface/Sun.gif");
+    MoviePixmapItem *sunGif;
+    if (!sunPool.isEmpty()) {
+        sunGif = sunPool.takeLast();
+        sunGif->setVisible(true);
+    } else {
+        // 创建阳光动画对象，点击事件只连接一次，之后随对象重复使用
+        sunGif = new MoviePixmapItem("interface/Sun.gif");
+        sunGif->setZValue(2);  // 层级高于背景但低于植物
+        sunGroup->addToGroup(sunGif);  // 添加到阳光组
+        connect(sunGif, &MoviePixmapItem::click, [this, sunGif] { collectSun(sunGif); });
+    }
 
     // 根据阳光值调整缩放比例
     if (sunNum == 15)
         sunGif->setScale(46.0 / 79.0);  // 小阳光（15点）
     else if (sunNum != 25)
         sunGif->setScale(100.0 / 79.0);  // 大阳光（非25点，可能是50点）
+    else
+        sunGif->setScale(1.0);
 
     // 设置阳光属性
-    sunGif->setZValue(2);  // 层级高于背景但低于植物
     sunGif->setOpacity(0.8);  // 80%透明度
     sunGif->setCursor(Qt::PointingHandCursor);  // 鼠标悬停变手型
-    sunGroup->addToGroup(sunGif);  // 添加到阳光组
+    suns.insert(sunGif, { sunNum, -1, false });
+    return sunGif;
+}
 
-    // 存储定时器与连接对象（用于后续释放）
-    QSharedPointer<QTimer *> timer(new QTimer *(nullptr));
-    QSharedPointer<QMetaObject::Connection> connection(new QMetaObject::Connection);
+// 落地（动画未被收集打断）后 8 秒（80 轮）未收集则消失
+void GameScene::sunLanded(MoviePixmapItem *sunGif)
+{
+    auto iter = suns.find(sunGif);
+    if (iter != suns.end() && !iter->collected)
+        iter->expireTicks = 80;
+}
 
-    // 点击阳光事件处理
-    *connection = connect(sunGif, &MoviePixmapItem::click, [this, sunGif, sunNum, timer] {
-        if (choose != 0) return;  // 正在选择时不响应
-        if (*timer) delete *timer;  // 清除之前的定时器
-
-        QSound::play(":/audio/points.wav");  // 播放收集音效
-        // 阳光移动到阳光数值框并缩放消失
-        Animate(sunGif, this).finish().move(QPointF(100, 0)).speed(1).scale(34.0 / 79.0).finish([this, sunGif, sunNum] {
-            delete sunGif;  // 销毁阳光对象
-            this->sunNum += sunNum;  // 增加阳光数值
-            updateSunNum();  // 更新阳光显示
-        });
+void GameScene::collectSun(MoviePixmapItem *sunGif)
+{
+    if (choose != 0) return;  // 正在选择时不响应
+    auto iter = suns.find(sunGif);
+    if (iter == suns.end() || iter->collected)
+        return;  // 每个阳光只能收集一次
+    iter->collected = true;
+    int value = iter->sunNum;
+
+    AudioManager::play(":/audio/points.wav");  // 播放收集音效
+    // 阳光移动到阳光数值框并缩放消失
+    Animate(sunGif, this).finish().move(QPointF(100, 0)).speed(1).scale(34.0 / 79.0).finish([this, sunGif, value] {
+        releaseSun(sunGif);
+        creditSun(value);
     });
+}
 
-    // 返回阳光对象与完成回调函数
-    return qMakePair(sunGif, [this, sunGif, timer, connection](bool finished) {
-        if (finished) {
-            // 8秒后未收集则自动消失
-            (*timer = new Timer(this, 8000, [this, sunGif, connection] {
-                disconnect(*connection);  // 断开点击事件连接
-                sunGif->setCursor(Qt::ArrowCursor);  // 鼠标样式改为箭头
-                // 淡出动画
-                Animate(sunGif, this).fade(0).duration(500).finish([sunGif] {
-                    delete sunGif;  // 销毁阳光对象
-                });
-            }))->start();
-        }
-    });
+// 阳光放回对象池
+void GameScene::releaseSun(MoviePixmapItem *sunGif)
+{
+    suns.remove(sunGif);
+    sunGif->stop();
+    sunGif->setVisible(false);
+    sunPool.push_back(sunGif);
 }
 
+void GameScene::creditSun(int sunNum)
+{
+    this->sunNum += sunNum;  // 增加阳光数值
+    updateSunNum();  // 更新阳光显示
+}
+
+// 每轮监控推进已落地阳光的存在时间，到期的阳光淡出后放回对象池
+void GameScene::updateSuns()
+{
+    for (auto iter = suns.begin(); iter != suns.end(); ++iter) {
+        if (iter->collected || iter->expireTicks < 0 || --iter->expireTicks > 0)
+            continue;
+        MoviePixmapItem *sunGif = iter.key();
+        iter->collected = true;  // 淡出期间不能再收集
+        sunGif->setCursor(Qt::ArrowCursor);  // 鼠标样式改为箭头
+        Animate(sunGif, this).fade(0).duration(500).finish([this, sunGif] {
+            releaseSun(sunGif);
+        });
+    }
+}
+
+void GameScene::setAutoCollectSun(bool autoCollect)
+{
+    autoCollectSun = autoCollect;
+}
 
 void GameScene::beginSun(int sunNum)
 {
-    // 创建阳光对象并获取回调函数
-    auto sunGifAndOnFinished = newSun(sunNum);
-    MoviePixmapItem *sunGif = sunGifAndOnFinished.first;
-    std::function<void(bool)> onFinished = sunGifAndOnFinished.second;
+    // 开局先掉落一个，之后每 3-12 秒（30-120 轮）掉落一个
+    dropSun(sunNum);
+    productionScheduler->addProducer({ nullptr, sunNum, 30, 120, 0 }, 30 + qrand() % 90);
+}
+
+void GameScene::dropSun(int sunNum)
+{
+    if (autoCollectSun) {
+        creditSun(sunNum);
+        return;
+    }
+    MoviePixmapItem *sunGif = newSun(sunNum);
 
     // 随机生成阳光目标位置（格子内）
     double toX = coordinate.getX(1 + qrand() % coordinate.colCount()),
@@ -821,36 +1006,85 @@ void GameScene::beginSun(int sunNum)
     sunGif->setPos(toX, -100);  // 初始位置在场景外（顶部）
     sunGif->start();  // 播放阳光动画
     // 下落动画（速度0.04，完成后调用回调）
-    Animate(sunGif, this).move(QPointF(toX, toY - 53)).speed(0.04).finish(onFinished);
+    Animate(sunGif, this).move(QPointF(toX, toY - 53)).speed(0.04).finish([this, sunGif](bool finished) {
+        if (finished)
+            sunLanded(sunGif);
+    });
+}
+
+void GameScene::growSun(PlantInstance *plant, int sunNum)
+{
+    if (autoCollectSun) {
+        creditSun(sunNum);
+        return;
+    }
+    MoviePixmapItem *sunGif = newSun(sunNum);                   // 阳光动画对象
+
+    // 计算阳光生成的起始与目标位置
+    double fromX = coordinate.getX(plant->col) - sunGif->boundingRect().width() / 2 + 15,
+           toX = coordinate.getX(plant->col) - qrand() % 80,           // 随机水平偏移
+           toY = coordinate.getY(plant->row) - sunGif->boundingRect().height();
+
+    // 初始化阳光动画：
+    sunGif->setScale(0.6);              // 初始缩放比例
+    sunGif->setPos(fromX, toY - 25);     // 初始位置（植物上方）
+    sunGif->start();                    // 启动动画播放
+
+    // 定义阳光动画轨迹（使用Animate类实现平滑移动）：
+    Animate(sunGif, this)
+        .move(QPointF((fromX + toX) / 2, toY - 50))  // 第一段移动（向上弧线路径）
+        .scale(0.9)                                 // 缩放变化
+        .speed(0.2)                                 // 移动速度
+        .shape(QTimeLine::EaseOutCurve)              // 缓出曲线（开始快，结束慢）
+        .finish()                                   // 第一段结束回调（空）
+        .move(QPointF(toX, toY))                    // 第二段移动（落至目标位置）
+        .scale(1.0)                                 // 恢复原始大小
+        .speed(0.2)                                 // 移动速度
+        .shape(QTimeLine::EaseInCurve)               // 缓入曲线（开始慢，结束快）
+        .finish([this, sunGif](bool finished) {     // 落地后开始计算存在时间
+            if (finished)
+                sunLanded(sunGif);
+        });
+}
 
-    // 定时生成下一个阳光（3-12秒随机间隔）
-    (new Timer(this, (qrand() % 9000 + 3000), [this, sunNum] { beginSun(sunNum); }))->start();
+ProductionScheduler *GameScene::getProductionScheduler() const
+{
+    return productionScheduler;
 }
 
 void GameScene::doCoolTime(int index)
 {
     auto &item = selectedPlantArray[index];  // 当前植物原型
-    auto &plantCardItem = cardGraphics[index].plantCard;  // 当前卡片UI
 
     // 初始化卡片状态
-    plantCardItem->setPercent(0);  // 冷却进度0%
-    plantCardItem->setChecked(false);  // 卡片禁用
+    seedBank->setPercent(index, 0);  // 冷却进度0%
+    seedBank->setChecked(index, false);  // 卡片禁用
 
-    // 标记冷却未完成并更新提示框
+    // 标记冷却未完成并更新提示框，之后由 updateCardCooldowns 推进
+    cardReady[index].coolUntil = gameTime() + qRound(item->coolTime * 1000);
     if (cardReady[index].cool) {
         cardReady[index].cool = false;
         updateTooltip(index);
     }
+}
 
-    // 创建冷却进度条动画
-    (new TimeLine(this, qRound(item->coolTime * 1000), 20, [this, index](qreal x) {
-        cardGraphics[index].plantCard->setPercent(x);  // 更新进度条
-    }, [this, index] {
-        cardReady[index].cool = true;  // 冷却完成
-        if (cardReady[index].sun)  // 阳光足够时激活卡片
-            cardGraphics[index].plantCard->setChecked(true);
-        updateTooltip(index);  // 更新提示框
-    }))->start();
+void GameScene::updateCardCooldowns()
+{
+    qint64 now = gameTime();
+    for (int i = 0; i < cardReady.size(); ++i) {
+        if (cardReady[i].cool)
+            continue;
+        qint64 remaining = cardReady[i].coolUntil - now;
+        if (remaining > 0) {
+            seedBank->setPercent(i, 1 - remaining / (selectedPlantArray[i]->coolTime * 1000));  // 更新进度条
+            continue;
+        }
+        seedBank->setPercent(i, 1.0);
+        cardReady[i].cool = true;  // 冷却完成
+        if (cardReady[i].sun)  // 阳光足够时激活卡片
+            seedBank->setChecked(i, true);
+        updateTooltip(i);  // 更新提示框
+    }
 }
 
 void GameScene::updateSunNum()
@@ -863,7 +1097,6 @@ void GameScene::updateSunNum()
     // 遍历所有卡片，根据阳光值更新卡片状态
     for (int i = 0; i < selectedPlantArray.size(); ++i) {
         auto &item = selectedPlantArray[i];  // 当前植物原型
-        auto &plantCardItem = cardGraphics[i].plantCard;  // 当前卡片UI
 
         if (item->sunNum <= sunNum) {  // 阳光足够
             if (!cardReady[i].sun) {  // 阳光状态未更新时
@@ -871,14 +1104,14 @@ void GameScene::updateSunNum()
                 updateTooltip(i);  // 更新提示框
             }
             if (cardReady[i].cool)  // 冷却也完成时
-                plantCardItem->setChecked(true);  // 激活卡片
+                seedBank->setChecked(i, true);  // 激活卡片
         }
         else {  // 阳光不足
             if (cardReady[i].sun) {  // 阳光状态未更新时
                 cardReady[i].sun = false;  // 标记阳光不足
                 updateTooltip(i);  // 更新提示框
             }
-            plantCardItem->setChecked(false);  // 禁用卡片
+            seedBank->setChecked(i, false);  // 禁用卡片
         }
     }
 }
@@ -888,13 +1121,14 @@ QPointF GameScene::sizeToPoint(const QSizeF &size)
     return QPointF(size.width(), size.height());  // 直接转换宽高为坐标点
 }
 
-void GameScene::customSpecial(const QString &name, int col, int row)
+PlantInstance *GameScene::customSpecial(const QString &name, int col, int row)
 {
     // 创建植物实例（通过名称查找原型）
     PlantInstance *plantInstance = PlantInstanceFactory(getPlantProtoType(name));
     plantInstance->birth(col, row);  // 初始化植物位置
 
     // 存储植物实例到管理容器
+    plantInstance->instanceIndex = plantInstances.size();
     plantInstances.push_back(plantInstance);
     auto key = qMakePair(col, row);  // 位置键值对
 
@@ -902,9 +1136,11 @@ void GameScene::customSpecial(const QString &name, int col, int row)
     if (!plantPosition.contains(key))
         plantPosition.insert(key, QMap<int, PlantInstance *>());
     plantPosition[key].insert(plantInstance->plantProtoType->pKind, plantInstance);
+    updateCell(col, row);
 
     // 更新UUID映射表
     plantUuid.insert(plantInstance->uuid, plantInstance);
+    return plantInstance;
 }
 
 void GameScene::addToGame(QGraphicsItem *item)
@@ -914,7 +1150,7 @@ void GameScene::addToGame(QGraphicsItem *item)
 
 void GameScene::beginZombies()
 {
-    QSound::play(":/audio/awooga.wav");  // 播放警报声（僵尸来袭）
+    AudioManager::play(":/audio/awooga.wav");  // 播放警报声（僵尸来袭）
 
     // 旗帜进度条下移（显示波次进度）
     Animate(flagMeter, this).move(QPointF(700, 560)).speed(0.5).finish();
@@ -922,19 +1158,22 @@ void GameScene::beginZombies()
 
     // 循环播放僵尸呻吟声（随机选择音效）
     QSharedPointer<std::function<void(void)> > playGroan(new std::function<void(void)>);
-    *playGroan = [this, playGroan] {
+    QWeakPointer<std::function<void(void)> > weakPlayGroan = playGroan;
+    // 函数自身只持有弱引用，由挂起的计时器持有强引用，场景销毁时随计时器一起释放
+    *playGroan = [this, weakPlayGroan] {
+        QSharedPointer<std::function<void(void)> > playGroan = weakPlayGroan.toStrongRef();
         switch (qrand() % 6) {
-            case 0: QSound::play(":/audio/groan1.wav"); break;
-            case 1: QSound::play(":/audio/groan2.wav"); break;
-            case 2: QSound::play(":/audio/groan3.wav"); break;
-            case 3: QSound::play(":/audio/groan4.wav"); break;
-            case 4: QSound::play(":/audio/groan5.wav"); break;
-            default: QSound::play(":/audio/groan6.wav"); break;
+            case 0: AudioManager::play(":/audio/groan1.wav"); break;
+            case 1: AudioManager::play(":/audio/groan2.wav"); break;
+            case 2: AudioManager::play(":/audio/groan3.wav"); break;
+            case 3: AudioManager::play(":/audio/groan4.wav"); break;
+            case 4: AudioManager::play(":/audio/groan5.wav"); break;
+            default: AudioManager::play(":/audio/groan6.wav"); break;
         }
         // 每20秒播放一次
-        (new Timer(this, 20000, *playGroan))->start();
+        (new Timer(this, 20000, [playGroan] { (*playGroan)(); }))->start();
     };
-    (new Timer(this, 20000, *playGroan))->start();
+    (new Timer(this, 20000, [playGroan] { (*playGroan)(); }))->start();
 }
 
 void GameScene::prepareGrowPlants(std::function<void(void)> functor)
@@ -1006,36 +1245,67 @@ void GameScene::advanceFlag()
     auto &flagToSumNum = gameLevelData->flagToSumNum;
     selectFlagZombie(flagToSumNum.second[qLowerBound(flagToSumNum.first, waveNum) - flagToSumNum.first.begin()]);
 }
+// 把 list[index] 换到末尾后删除，并更新被换过来的实体记录的下标
+template <typename T>
+static void swapRemove(QList<T *> &list, int index)
+{
+    if (index != list.size() - 1) {
+        list[index] = list.last();
+        list[index]->instanceIndex = index;
+    }
+    list.removeLast();
+}
+
+// 实体死亡时停下挂在它图片上的动画与计时器（如倭瓜起跳后的压扁），图片回收前它们不再作用于死亡的实体
+static void stopPictureTimers(TweenEngine *tweens, MoviePixmapItem *picture)
+{
+    tweens->cancel(picture);
+    for (QObject *child: picture->children()) {
+        if (Timer *timer = dynamic_cast<Timer *>(child))
+            timer->stop();
+    }
+}
+
 void GameScene::plantDie(PlantInstance *plant)
 {
+    if (plant->dead)
+        return;
+    plant->dead = true;
+    plant->canTrigger = false;  // 本轮剩余的检测中不再触发
+    plant->picture->setVisible(false);
+    stopPictureTimers(TweenEngine::of(this), plant->picture);
+
     // 从位置映射中移除植物
     plantPosition[qMakePair(plant->col, plant->row)].remove(plant->plantProtoType->pKind);
+    updateCell(plant->col, plant->row);
 
-    // 移除植物触发区域
-    for (int i = 0; i < plantTriggers[plant->row].size(); ) {
-        if (plantTriggers[plant->row][i]->plant == plant) {
-            delete plantTriggers[plant->row][i];
-            plantTriggers[plant->row].removeAt(i);
-            continue;
-        }
-        ++i;
+    // 注销植物自己的触发区域：各行的触发区域列表保持有序，死亡植物的触发区域（不再触发）在本轮结束时一并移出并释放
+    for (auto iter = plant->triggers.begin(); iter != plant->triggers.end(); ++iter) {
+        deadTriggers += iter.value();
+        dirtyTriggerRows.insert(iter.key());
     }
 
     // 从实例列表和UUID映射中移除
-    plantInstances.removeAt(plantInstances.indexOf(plant));
+    swapRemove(plantInstances, plant->instanceIndex);
     plantUuid.remove(plant->uuid);
-
-    // 释放植物对象内存
-    delete plant;
+    deadPlants.push_back(plant);
 }
 
 
 void GameScene::zombieDie(ZombieInstance *zombie)
 {
-    // 从实例列表和行僵尸列表中移除
-    int i = zombieInstances.indexOf(zombie);
-    zombieInstances.removeAt(i);
-    zombieRow[zombie->row].removeOne(zombie);
+    if (zombie->dead)
+        return;
+    zombie->dead = true;
+    zombie->hp = 0;  // 行僵尸列表保持按位置有序，死亡僵尸在本轮结束时才移出，在此之前按生命值被跳过
+    zombie->picture->setVisible(false);
+    stopPictureTimers(TweenEngine::of(this), zombie->picture);
+
+    // 从实例列表中移除
+    swapRemove(zombieInstances, zombie->instanceIndex);
+    dirtyZombieRows.insert(zombie->row);  // 伤害、闪烁与状态效果列表中的死亡僵尸由各自的更新或本轮结束时一并移出
+    zombieUuid.remove(zombie->uuid);
+    deadZombies.push_back(zombie);
 
     // 检查是否所有僵尸已被消灭
     if (zombieInstances.isEmpty()) {
@@ -1047,10 +1317,85 @@ void GameScene::zombieDie(ZombieInstance *zombie)
             gameWin();  // 触发游戏胜利
         }
     }
+}
 
-    // 从UUID映射中移除并释放内存
-    zombieUuid.remove(zombie->uuid);
-    delete zombie;
+void GameScene::bulletDie(Bullet *bullet)
+{
+    deadBullets.push_back(bullet);
+}
+
+// 本轮中死亡的实体此时不再被任何检测或回调使用，统一释放
+void GameScene::reclaimDead()
+{
+    // 先把死亡的僵尸与触发区域移出各行的有序列表（每行只扫描一遍）
+    for (int row: dirtyZombieRows) {
+        QList<ZombieInstance *> &zombies = zombieRow[row];
+        zombies.erase(std::remove_if(zombies.begin(), zombies.end(), [](ZombieInstance *zombie) { return zombie->dead; }),
+                      zombies.end());
+    }
+    dirtyZombieRows.clear();
+    for (int row: dirtyTriggerRows) {
+        QList<Trigger *> &triggers = plantTriggers[row];
+        triggers.erase(std::remove_if(triggers.begin(), triggers.end(), [](Trigger *trigger) { return trigger->plant->dead; }),
+                       triggers.end());
+    }
+    dirtyTriggerRows.clear();
+    if (!deadZombies.isEmpty()) {
+        auto isDead = [](ZombieInstance *zombie) { return zombie->dead; };
+        damagedZombies.erase(std::remove_if(damagedZombies.begin(), damagedZombies.end(), isDead), damagedZombies.end());
+        hitFlashZombies.erase(std::remove_if(hitFlashZombies.begin(), hitFlashZombies.end(), isDead), hitFlashZombies.end());
+        statusEffectZombies.erase(std::remove_if(statusEffectZombies.begin(), statusEffectZombies.end(), isDead),
+                                  statusEffectZombies.end());
+    }
+
+    qDeleteAll(deadBullets);
+    deadBullets.clear();
+    qDeleteAll(deadZombies);
+    deadZombies.clear();
+    qDeleteAll(deadPlants);
+    deadPlants.clear();
+    qDeleteAll(deadTriggers);
+    deadTriggers.clear();
+}
+
+MoviePixmapItem *GameScene::takePicture()
+{
+    if (picturePool.isEmpty())
+        return new MoviePixmapItem;
+    return picturePool.takeLast();
+}
+
+// 清除实体留在图片上的一切：动画、子图形项（影子等）、以图片为父对象的计时器、信号连接与显示属性
+void GameScene::releasePicture(MoviePixmapItem *picture)
+{
+    TweenEngine::of(this)->cancel(picture);
+    qDeleteAll(picture->childItems());
+    picture->clearMovie();
+    qDeleteAll(picture->children());
+    picture->disconnect();
+    if (picture->scene())
+        removeItem(picture);
+    picture->setPos(0, 0);
+    picture->setZValue(0);
+    picture->setOpacity(1.0);
+    picture->setScale(1.0);
+    picture->setVisible(true);
+    picturePool.push_back(picture);
+}
+
+QGraphicsPixmapItem *GameScene::takeBulletPicture()
+{
+    if (bulletPicturePool.isEmpty())
+        return new QGraphicsPixmapItem;
+    return bulletPicturePool.takeLast();
+}
+
+void GameScene::releaseBulletPicture(QGraphicsPixmapItem *picture)
+{
+    if (picture->scene())
+        removeItem(picture);
+    picture->setVisible(true);  // 死亡时已隐藏，重复使用前恢复
+    bulletPicturePool.push_back(picture);
 }
 
 void GameScene::selectFlagZombie(int levelSum)
@@ -1060,7 +1405,7 @@ void GameScene::selectFlagZombie(int levelSum)
 
     // 处理大波次（带有旗帜僵尸）
     if (gameLevelData->largeWaveFlag.contains(waveNum)) {
-        QSound::play(":/audio/siren.wav");  // 播放警报声
+        AudioManager::play(":/audio/siren.wav");  // 播放警报声
         Zombie *flagZombie = getZombieProtoType("oFlagZombie");  // 获取旗帜僵尸原型
         levelSum -= flagZombie->level;  // 扣除旗帜僵尸等级
         zombies.push_back(flagZombie);
@@ -1105,18 +1450,7 @@ void GameScene::selectFlagZombie(int levelSum)
                 row = qrand() % coordinate.rowCount() + 1;
             } while (!zombie->canPass(row));
 
-            // 创建僵尸实例并初始化
-            ZombieInstance *zombieInstance = ZombieInstanceFactory(zombie);
-            zombieInstance->birth(row);
-            zombieInstances.push_back(zombieInstance);
-            zombieRow[row].push_back(zombieInstance);
-
-            // 按位置排序该行僵尸（从左到右）
-            qSort(zombieRow[row].begin(), zombieRow[row].end(), [](ZombieInstance *a, ZombieInstance *b) {
-                return b->attackedLX < a->attackedLX;
-            });
-
-            zombieUuid.insert(zombieInstance->uuid, zombieInstance);  // 记录UUID映射
+            spawnZombie(zombie, row);
         }))->start();
     }
 
@@ -1126,6 +1460,25 @@ void GameScene::selectFlagZombie(int levelSum)
         qDebug() << "    " << item->eName;
 }
 
+// 在指定行生成僵尸实例并登记到场景容器
+ZombieInstance *GameScene::spawnZombie(Zombie *zombie, int row)
+{
+    // 创建僵尸实例并初始化
+    ZombieInstance *zombieInstance = ZombieInstanceFactory(zombie);
+    zombieInstance->birth(row);
+    zombieInstance->instanceIndex = zombieInstances.size();
+    zombieInstances.push_back(zombieInstance);
+    zombieRow[row].push_back(zombieInstance);
+
+    // 按位置排序该行僵尸（从左到右）
+    qSort(zombieRow[row].begin(), zombieRow[row].end(), [](ZombieInstance *a, ZombieInstance *b) {
+        return b->attackedLX < a->attackedLX;
+    });
+
+    zombieUuid.insert(zombieInstance->uuid, zombieInstance);  // 记录UUID映射
+    return zombieInstance;
+}
+
 // 根据行列坐标获取植物（可能多个）
 QMap<int, PlantInstance *> GameScene::getPlant(int col, int row)
 {
@@ -1156,6 +1509,86 @@ bool GameScene::isTombstone(int col, int row) const
     return qBinaryFind(tombstones, qMakePair(col, row)) != tombstones.end();
 }
 
+// 可种植位图中格子对应的位，超出草坪（canGrow 只接受第1~9列、第1~5行）时为 0
+static quint64 placementBit(int col, int row)
+{
+    if (col < 1 || col > 9 || row < 1 || row > 5)
+        return 0;
+    return quint64(1) << ((row - 1) * 9 + (col - 1));
+}
+
+bool GameScene::canPlace(const Plant *plant, int col, int row)
+{
+    return getPlacementMask(plant) & placementBit(col, row);
+}
+
+quint64 GameScene::getPlacementMask(const Plant *plant)
+{
+    auto iter = placementMasks.find(plant);
+    if (iter != placementMasks.end())
+        return *iter;
+    quint64 mask = 0;
+    for (int row = 1; row <= 5; ++row)
+        for (int col = 1; col <= 9; ++col)
+            if (plant->canGrow(col, row))
+                mask |= placementBit(col, row);
+    placementMasks.insert(plant, mask);
+    return mask;
+}
+
+// canGrow 只取决于格子本身（地形、弹坑、墓碑与格子中的植物），因此只需重新计算这一格
+void GameScene::updatePlacement(int col, int row)
+{
+    quint64 bit = placementBit(col, row);
+    if (!bit)
+        return;
+    for (auto iter = placementMasks.begin(); iter != placementMasks.end(); ++iter) {
+        if (iter.key()->canGrow(col, row))
+            *iter |= bit;
+        else
+            *iter &= ~bit;
+    }
+}
+
+// 格子在 eatTargets 中的下标，超出草坪时为 -1
+int GameScene::cellIndex(int col, int row) const
+{
+    if (col < 0 || col > coordinate.colCount() || row < 0 || row > coordinate.rowCount())
+        return -1;
+    return row * (coordinate.colCount() + 1) + col;
+}
+
+const QVector<PlantInstance *> &GameScene::getEatTargets(int col, int row) const
+{
+    static const QVector<PlantInstance *> empty;
+    int index = cellIndex(col, row);
+    return index < 0 ? empty : eatTargets[index];
+}
+
+void GameScene::updateEatTargets(int col, int row)
+{
+    int index = cellIndex(col, row);
+    if (index < 0)
+        return;
+    QVector<PlantInstance *> &targets = eatTargets[index];
+    targets.clear();
+    auto iter = plantPosition.constFind(qMakePair(col, row));
+    if (iter == plantPosition.constEnd())
+        return;
+    // QMap 按 pKind 从小到大排列，倒序取出
+    for (auto plant = iter->constEnd(); plant != iter->constBegin();) {
+        --plant;
+        if ((*plant)->plantProtoType->canEat)
+            targets.push_back(*plant);
+    }
+}
+
+void GameScene::updateCell(int col, int row)
+{
+    updatePlacement(col, row);
+    updateEatTargets(col, row);
+}
+
 // 获取坐标系统引用
 Coordinate &GameScene::getCoordinate()
 {
@@ -1166,6 +1599,7 @@ Coordinate &GameScene::getCoordinate()
 void GameScene::addTrigger(int row, Trigger *trigger)
 {
     plantTriggers[row].push_back(trigger);
+    ++triggerEpochs[row];  // 僵尸已算出的空闲区间可能包含新的触发区域，全部作废
 
     // 按触发范围排序，优化后续检测效率
     qSort(plantTriggers[row].begin(), plantTriggers[row].end(), [](const Trigger *a, const Trigger *b) {
@@ -1177,42 +1611,405 @@ void GameScene::addTrigger(int row, Trigger *trigger)
 void GameScene::beginMonitor()
 {
     monitorTimer->setInterval(100);
-    connect(monitorTimer, &QTimer::timeout, [this] {
-        // 遍历每一行
-        for (int row = 1; row <= coordinate.rowCount(); ++row) {
-            QList<ZombieInstance *> zombiesCopy = zombieRow[row];  // 复制当前行僵尸列表
-
-            // 遍历该行所有僵尸
-            for (ZombieInstance *zombie: zombiesCopy) {
-                QUuid zombieUuid = zombie->uuid;
-
-                // 检查僵尸是否存活且在有效范围内
-                if (zombie->hp > 0 && zombie->ZX <= 900) {
-                    QList<Trigger *> triggerCopy = plantTriggers[row];  // 复制当前行触发区域
-
-                    // 遍历所有触发区域，检测碰撞
-                    for (auto trigger: triggerCopy) {
-                        if (trigger->plant->canTrigger  // 植物可触发
-                            && trigger->from <= zombie->attackedLX  // 僵尸进入触发左边界
-                            && trigger->to >= zombie->attackedLX) {  // 僵尸进入触发右边界
-                            trigger->plant->triggerCheck(zombie, trigger);  // 触发植物效果
-                        }
+    renderClock.start();
+    if (gGameClock) {
+        scheduleMonitor();
+        return;
+    }
+    connect(monitorTimer, &QTimer::timeout, [this] { monitorTimeout(); });
+    monitorTimer->start();
+
+    // 绘制端按帧取快照并插值，与监控的节奏无关
+    renderTimer->setInterval(16);
+    renderTimer->setTimerType(Qt::PreciseTimer);
+    connect(renderTimer, &QTimer::timeout, [this] { renderSnapshot(); });
+    renderTimer->start();
+}
+
+void GameScene::monitorTimeout()
+{
+    PerfScope scope(PerfMonitor::Monitor);
+    TRACE_SCOPE("sim", "GameScene::monitorTick");
+    if (!tickObserver) {
+        monitorTick();
+        return;
+    }
+    QElapsedTimer elapsed;
+    elapsed.start();
+    monitorTick();
+    tickObserver(elapsed.nsecsElapsed());
+}
+
+// 游戏结束（monitorTimer 被释放）后不再预约
+void GameScene::scheduleMonitor()
+{
+    gGameClock->schedule(monitorTimer->interval(), this, [this] {
+        if (!monitorTimer)
+            return;
+        monitorTimeout();
+        if (monitorTimer)
+            scheduleMonitor();
+    });
+}
+
+void GameScene::queueDamage(ZombieInstance *zombie)
+{
+    damagedZombies.push_back(zombie);
+}
+
+// 每个僵尸本轮的伤害合并为一次结算（多颗豌豆只产生一次受击效果）
+void GameScene::applyDamage()
+{
+    QList<ZombieInstance *> zombies;
+    zombies.swap(damagedZombies);
+    for (ZombieInstance *zombie: zombies) {
+        int damage = zombie->pendingDamage;
+        zombie->pendingDamage = 0;
+        if (!zombie->dead)
+            zombie->takeDamage(damage);
+    }
+}
+
+void GameScene::addHitFlash(ZombieInstance *zombie)
+{
+    if (hitFlashZombies.isEmpty())
+        hitFlashClock.start();
+    hitFlashZombies.push_back(zombie);
+}
+
+void GameScene::updateHitFlashes()
+{
+    if (hitFlashZombies.isEmpty())
+        return;
+    int elapsed = int(hitFlashClock.restart());
+    // 原地压缩：仍在闪烁的僵尸前移，结束闪烁或已死亡的僵尸被跳过
+    int kept = 0;
+    for (int i = 0; i < hitFlashZombies.size(); ++i) {
+        ZombieInstance *zombie = hitFlashZombies[i];
+        if (zombie->dead)
+            continue;
+        zombie->hitFlash -= elapsed;
+        if (zombie->hitFlash > 0) {
+            hitFlashZombies[kept++] = zombie;
+            continue;
+        }
+        zombie->hitFlash = 0;
+        zombie->picture->setOpacity(1);
+    }
+    hitFlashZombies.erase(hitFlashZombies.begin() + kept, hitFlashZombies.end());
+}
+
+// 效果被提前清除的僵尸在下一轮更新前仍在列表中，由僵尸上的标记避免重复登记
+void GameScene::addStatusEffectZombie(ZombieInstance *zombie)
+{
+    if (zombie->statusEffectListed)
+        return;
+    zombie->statusEffectListed = true;
+    statusEffectZombies.push_back(zombie);
+}
+
+void GameScene::updateStatusEffects()
+{
+    // 原地压缩：效果结束或已死亡的僵尸被跳过（更新中新登记的僵尸追加在末尾，同样会被处理）
+    int kept = 0;
+    for (int i = 0; i < statusEffectZombies.size(); ++i) {
+        ZombieInstance *zombie = statusEffectZombies[i];
+        if (!zombie->dead)
+            zombie->updateStatusEffects();
+        if (zombie->dead || zombie->statusEffects.isEmpty())
+            zombie->statusEffectListed = false;
+        else
+            statusEffectZombies[kept++] = zombie;
+    }
+    statusEffectZombies.erase(statusEffectZombies.begin() + kept, statusEffectZombies.end());
+}
+
+void GameScene::updatePlantCooldowns()
+{
+    QList<PlantInstance *> plantsCopy = plantInstances;
+    for (PlantInstance *plant: plantsCopy)
+        plant->updateCooldowns();
+}
+
+// 执行一次监控：触发器检测与僵尸行为更新
+void GameScene::monitorTick()
+{
+    applyDamage();
+    updateStatusEffects();
+    updatePlantCooldowns();
+    productionScheduler->advance();
+    updateSuns();
+    updateCardCooldowns();
+    if (gJobSystem)
+        monitorTickParallel();
+    else
+        monitorTickSerial();
+    reclaimDead();
+
+    ++tickCount;
+    publishSnapshot();
+    if (gGameClock)
+        renderSnapshot();  // 虚拟时钟下没有帧计时器，每轮直接应用
+}
+
+// 快照只含值，不引用任何游戏对象；绘制时按 uuid 找到僵尸的图元
+void GameScene::publishSnapshot()
+{
+    RenderSnapshot &snapshot = snapshots.back();
+    snapshot.tick = tickCount;
+    snapshot.zombies.clear();  // 保留容量，稳定后不再分配
+    for (ZombieInstance *zombie: zombieInstances)
+        snapshot.zombies.push_back({ zombie->uuid, zombie->X, zombie->hp });
+    snapshots.publish();
+}
+
+// 快照中的僵尸此后可能已经死亡并被释放，此时返回空
+MoviePixmapItem *GameScene::zombiePicture(const RenderSnapshot::ZombieState &zombie) const
+{
+    ZombieInstance *instance = zombieUuid.value(zombie.uuid);
+    return instance ? instance->picture : nullptr;
+}
+
+// 插值使画面比模拟晚最多一轮，换来僵尸在两轮之间每帧平滑移动；
+// 用时取实际测得的快照间隔，监控变慢（或降低模拟频率）时仍然连贯
+void GameScene::renderSnapshot()
+{
+    qint64 now = renderClock.elapsed();
+    if (snapshots.update()) {
+        const QVector<RenderSnapshot::ZombieState> &zombies = snapshots.front().zombies;
+        renderFrom.resize(zombies.size());
+        for (int i = 0; i < zombies.size(); ++i) {
+            MoviePixmapItem *picture = zombiePicture(zombies[i]);
+            renderFrom[i] = picture ? picture->x() : zombies[i].x;  // 新出生的僵尸图元已在出生位置
+        }
+        renderDuration = gGameClock || renderArrival < 0 ? 0 : now - renderArrival;
+        renderArrival = now;
+        renderSettled = false;
+    }
+    if (renderSettled)
+        return;
+
+    TRACE_SCOPE("render", "GameScene::renderSnapshot");
+    qreal progress = renderDuration > 0 ? qMin(qreal(1), qreal(now - renderArrival) / renderDuration) : 1;
+    const QVector<RenderSnapshot::ZombieState> &zombies = snapshots.front().zombies;
+    for (int i = 0; i < zombies.size(); ++i) {
+        if (zombies[i].hp <= 0)
+            continue;  // 与 checkActs 一致，生命值耗尽的僵尸不再移动，图元交给死亡动画
+        if (MoviePixmapItem *picture = zombiePicture(zombies[i]))
+            picture->setX(renderFrom[i] + (zombies[i].x - renderFrom[i]) * progress);
+    }
+    renderSettled = progress >= 1;
+}
+
+// 僵尸只在触发区域之间移动时，下一次进入触发区域的位置（左侧最近的右边界，或右侧最近的左边界）可以预先算出：
+// 僵尸不在任何触发区域中时记下这段空闲区间，之后无论速度、减速或啃食状态如何变化，
+// 只要仍在区间内就不必逐个检测本行的触发区域，没有僵尸靠近的植物不产生任何开销。
+// 触发区域只会随植物死亡而减少（区间只会变大，已算出的区间仍然成立），新增时递增本行版本使区间作废
+// triggers 为僵尸所在行的触发区域（并行检测时为该行的副本）；工作线程也会调用，只能以 const 方式读取场景的容器
+bool GameScene::needsTriggerCheck(ZombieInstance *zombie, const QList<Trigger *> &triggers) const
+{
+    qreal x = zombie->attackedLX;
+    quint32 epoch = triggerEpochs.at(zombie->row);
+    if (zombie->triggerEpoch == epoch && zombie->triggerFreeFrom < x && x < zombie->triggerFreeTo)
+        return false;
+
+    qreal freeFrom = -qInf(), freeTo = qInf();
+    for (const Trigger *trigger: triggers) {
+        if (trigger->plant->dead)
+            continue;  // 不再触发，本轮结束时移出
+        if (trigger->from <= x && trigger->to >= x)
+            return true;
+        if (trigger->to < x)
+            freeFrom = qMax(freeFrom, trigger->to);
+        else
+            freeTo = qMin(freeTo, trigger->from);
+    }
+    zombie->triggerFreeFrom = freeFrom;
+    zombie->triggerFreeTo = freeTo;
+    zombie->triggerEpoch = epoch;
+    return false;
+}
+
+void GameScene::monitorTickSerial()
+{
+    // 遍历每一行
+    for (int row = 1; row <= coordinate.rowCount(); ++row) {
+        QList<ZombieInstance *> zombiesCopy = zombieRow[row];  // 复制当前行僵尸列表
+
+        // 遍历该行所有僵尸
+        for (ZombieInstance *zombie: zombiesCopy) {
+            QUuid zombieUuid = zombie->uuid;
+
+            // 检查僵尸是否存活、在有效范围内且可能位于某个触发区域中
+            if (zombie->hp > 0 && zombie->ZX <= 900 && needsTriggerCheck(zombie, plantTriggers.at(row))) {
+                QList<Trigger *> triggerCopy = plantTriggers[row];  // 复制当前行触发区域
+
+                // 遍历所有触发区域，检测碰撞
+                for (auto trigger: triggerCopy) {
+                    if (!trigger->plant->dead  // 死亡植物的触发区域在本轮结束时才移出
+                        && trigger->plant->canTrigger  // 植物可触发
+                        && trigger->from <= zombie->attackedLX  // 僵尸进入触发左边界
+                        && trigger->to >= zombie->attackedLX) {  // 僵尸进入触发右边界
+                        trigger->plant->triggerCheck(zombie, trigger);  // 触发植物效果
                     }
                 }
-
-                // 更新僵尸行为状态
-                ZombieInstance *z = getZombie(zombieUuid);
-                if (z)
-                    z->checkActs();
             }
 
-            // 重新排序僵尸列表（确保按位置排序）
-            qSort(zombieRow[row].begin(), zombieRow[row].end(), [](ZombieInstance *a, ZombieInstance *b) {
-                return b->attackedLX < a->attackedLX;
-            });
+            // 更新僵尸行为状态
+            ZombieInstance *z = getZombie(zombieUuid);
+            if (z)
+                z->checkActs();
+
+            // 游戏已结束（监控计时器被释放），停止本轮检测
+            if (!monitorTimer)
+                return;
+        }
+
+        // 重新排序僵尸列表（确保按位置排序）
+        qSort(zombieRow[row].begin(), zombieRow[row].end(), [](ZombieInstance *a, ZombieInstance *b) {
+            return b->attackedLX < a->attackedLX;
+        });
+    }
+}
+
+// monitorTick 的多线程版本，结果与单线程版本完全一致：
+// 1. 并行阶段：按行（行内再按每段 SpanSize 个僵尸）找出每个僵尸位于其中的触发区域，只读取游戏对象；
+// 2. 合并阶段：在本线程按原来的行、僵尸、触发器顺序复核并触发植物、移动僵尸，跨行效果（三线射手、火爆辣椒等）都在这一阶段发生。
+// 一轮检测中僵尸的血量只减不增、位置只在轮到它自己时改变、触发区域只会随植物死亡而减少，
+// 因此并行阶段得到的候选集合包含合并阶段按原逻辑会命中的全部触发器
+void GameScene::monitorTickParallel()
+{
+    static const int SpanSize = 64;
+    struct Span {
+        const QList<ZombieInstance *> *zombies;
+        const QList<Trigger *> *triggers;
+        QVector<Trigger *> *candidates;   // 与 zombies 下标对应的候选触发器
+        int begin, end;
+    };
+
+    const int rowCount = coordinate.rowCount();
+    QVector<QList<ZombieInstance *> > zombies(rowCount + 1);
+    QVector<QList<Trigger *> > triggers(rowCount + 1);
+    QVector<QVector<QVector<Trigger *> > > candidates(rowCount + 1);
+    QVector<Span> spans;
+    for (int row = 1; row <= rowCount; ++row) {
+        zombies[row] = zombieRow[row];
+        triggers[row] = plantTriggers[row];
+        candidates[row].resize(zombies[row].size());
+        for (int begin = 0; begin < zombies[row].size(); begin += SpanSize)
+            spans.push_back({ &zombies[row], &triggers[row], candidates[row].data(),
+                              begin, qMin(begin + SpanSize, zombies[row].size()) });
+    }
+
+    // 每个僵尸只属于一个分段，needsTriggerCheck 只写僵尸自己的空闲区间；触发区域只读本线程复制好的各行副本
+    gJobSystem->parallelFor(spans.size(), [this, &spans](int index) {
+        const Span &span = spans[index];
+        for (int i = span.begin; i < span.end; ++i) {
+            ZombieInstance *zombie = span.zombies->at(i);
+            if (zombie->hp <= 0 || zombie->ZX > 900 || !needsTriggerCheck(zombie, *span.triggers))
+                continue;
+            for (Trigger *trigger: *span.triggers) {
+                if (trigger->from <= zombie->attackedLX && trigger->to >= zombie->attackedLX)
+                    span.candidates[i].push_back(trigger);
+            }
         }
     });
-    monitorTimer->start();
+
+    for (int row = 1; row <= rowCount; ++row) {
+        QHash<ZombieInstance *, int> indexOf;
+        indexOf.reserve(zombies[row].size());
+        for (int i = 0; i < zombies[row].size(); ++i)
+            indexOf.insert(zombies[row][i], i);
+
+        QList<ZombieInstance *> zombiesCopy = zombieRow[row];
+        for (ZombieInstance *zombie: zombiesCopy) {
+            QUuid zombieUuid = zombie->uuid;
+
+            if (zombie->hp > 0 && zombie->ZX <= 900) {
+                // 候选触发器保持行内原有顺序；期间随植物死亡的跳过（触发区域在本轮结束时才释放）
+                int index = indexOf.value(zombie, -1);
+                const QVector<Trigger *> &triggerCandidates = index >= 0 ? candidates[row][index]
+                                                                         : plantTriggers[row].toVector();
+                for (auto trigger: triggerCandidates) {
+                    if (!trigger->plant->dead
+                        && trigger->plant->canTrigger
+                        && trigger->from <= zombie->attackedLX
+                        && trigger->to >= zombie->attackedLX) {
+                        trigger->plant->triggerCheck(zombie, trigger);
+                    }
+                }
+            }
+
+            ZombieInstance *z = getZombie(zombieUuid);
+            if (z)
+                z->checkActs();
+
+            if (!monitorTimer)
+                return;
+        }
+
+        qSort(zombieRow[row].begin(), zombieRow[row].end(), [](ZombieInstance *a, ZombieInstance *b) {
+            return b->attackedLX < a->attackedLX;
+        });
+    }
+}
+
+int GameScene::getPlantCount() const
+{
+    return plantInstances.size();
+}
+
+int GameScene::getPlantCount(const QString &eName) const
+{
+    int count = 0;
+    for (const PlantInstance *plant: plantInstances)
+        if (plant->plantProtoType->eName == eName)
+            ++count;
+    return count;
+}
+
+int GameScene::getZombieCount() const
+{
+    return zombieInstances.size();
+}
+
+int GameScene::getSunNum() const
+{
+    return sunNum;
+}
+
+int GameScene::getWaveNum() const
+{
+    return waveNum;
+}
+
+const QList<Plant *> &GameScene::getSelectedPlants() const
+{
+    return selectedPlantArray;
+}
+
+void GameScene::keyPressEvent(QKeyEvent *keyEvent)
+{
+    if (keyEvent->key() != Qt::Key_F3 || keyEvent->isAutoRepeat()) {
+        QGraphicsScene::keyPressEvent(keyEvent);
+        return;
+    }
+    // 关闭时释放统计器，各处的 PerfScope 随即退化为空操作
+    if (perfHud) {
+        delete perfHud;
+        perfHud = nullptr;
+        DestroyPerfMonitor();
+    }
+    else {
+        InitPerfMonitor();
+        perfHud = new PerfHud(this);
+        addItem(perfHud);
+    }
+}
+
+void GameScene::setTickObserver(std::function<void(qint64)> observer)
+{
+    tickObserver = observer;
 }
 
 // 根据UUID查找植物实例
@@ -1267,6 +2064,8 @@ Zombie *GameScene::getZombieProtoType(const QString &eName)
 // 开始播放关卡背景音乐
 void GameScene::beginBGM()
 {
+    if (AudioManager::isMuted())
+        return;
     backgroundMusic->blockSignals(true);  // 临时阻塞信号避免意外触发
     backgroundMusic->stop();
     backgroundMusic->blockSignals(false);
@@ -1277,8 +2076,14 @@ void GameScene::beginBGM()
 // 游戏失败处理
 void GameScene::gameLose()
 {
+    // 同一轮监控中可能有多个僵尸触发，只处理一次
+    if (!monitorTimer)
+        return;
     monitorTimer->stop();  // 停止游戏监控
-    delete monitorTimer;
+    renderTimer->stop();   // 不再有新的快照
+    monitorTimer->deleteLater();  // 可能正处于该计时器的timeout中，延迟释放
+    monitorTimer = nullptr;
+    emit gameFinished(false);
 
     // 播放失败音乐
     backgroundMusic->blockSignals(true);
@@ -1301,8 +2106,14 @@ void GameScene::gameLose()
 // 游戏胜利处理
 void GameScene::gameWin()
 {
+    // 同一轮监控中可能有多个僵尸触发，只处理一次
+    if (!monitorTimer)
+        return;
     monitorTimer->stop();  // 停止游戏监控
-    delete monitorTimer;
+    renderTimer->stop();   // 不再有新的快照
+    monitorTimer->deleteLater();  // 可能正处于该计时器的timeout中，延迟释放
+    monitorTimer = nullptr;
+    emit gameFinished(true);
 
     // 播放胜利音乐
     backgroundMusic->blockSignals(true);
@@ -1382,4 +2193,11 @@ void FlagMeter::updateFlagZombies(int flagZombies)
 Trigger::Trigger(PlantInstance *plant, qreal from, qreal to, int direction, int id)
         : plant(plant), from(from), to(to),  // 关联植物和触发范围
           direction(direction), id(id)  // 攻击方向和ID
-{}
+{
+    OBJECT_COUNTER_INC("Trigger");
+}
+
+Trigger::~Trigger()
+{
+    OBJECT_COUNTER_DEC("Trigger");
+}
@@ -6,21 +6,27 @@
 #include "Coordinate.h"    // 坐标系统头文件
 #include "Plant.h"         // 植物头文件
 #include "Zombie.h"       // 僵尸头文件
+#include "SimulationChannel.h"  // 模拟与绘制之间的快照
 
 class Plant;
 class PlantInstance;
 class Zombie;
 class GameLevelData;
 class MouseEventPixmapItem;
+class Timer;
 class MoviePixmapItem;
 class PlantCardItem;
 class TooltipItem;
+class SeedBankItem;
+class PerfHud;
+class ProductionScheduler;
 class Zombie;
 class ZombieInstance;
 
 // 触发器结构体（用于植物攻击等行为的触发）
 struct Trigger {
     Trigger(PlantInstance *plant, qreal from, qreal to, int direction, int id);
+    ~Trigger();
 
     PlantInstance *plant;  // 关联的植物实例
     qreal from, to;       // 触发范围（起始和结束位置）
@@ -62,8 +68,8 @@ public:
 
     // 添加元素到游戏场景
     void addToGame(QGraphicsItem *item);
-    // 执行特殊操作
-    void customSpecial(const QString &name, int col, int row);
+    // 在指定位置直接放置植物（不经过卡片与阳光流程）
+    PlantInstance *customSpecial(const QString &name, int col, int row);
     // 准备种植植物
     void prepareGrowPlants(std::function<void(void)> functor);
 
@@ -72,15 +78,35 @@ public:
     void loadAcessFinished();
     void beginBGM();       // 开始背景音乐
     void beginCool();      // 开始冷却
-    void beginSun(int sunNum); // 开始阳光生产
+    void beginSun(int sunNum); // 开始天空阳光的掉落
     void beginZombies();   // 开始生成僵尸
     void beginMonitor();   // 开始游戏监控
+    void monitorTick();    // 执行一次监控（触发器检测与僵尸行为）
+    QStringList levelImages() const; // 本关卡会用到的静态图片（用于后台预取）
     void gameLose();       // 游戏失败处理
     void gameWin();        // 游戏胜利处理
 
-    // 植物/僵尸死亡处理
+    // 植物/僵尸/子弹死亡处理：立即从场景的各个列表中移除并标记为死亡，本轮监控结束时统一释放
     void plantDie(PlantInstance *plant);
     void zombieDie(ZombieInstance *zombie);
+    void bulletDie(Bullet *bullet);
+
+    // 实体图片的对象池：实体释放时图片清空后放回池中，新实体优先复用
+    MoviePixmapItem *takePicture();
+    void releasePicture(MoviePixmapItem *picture);
+    QGraphicsPixmapItem *takeBulletPicture();
+    void releaseBulletPicture(QGraphicsPixmapItem *picture);
+
+    // 登记本轮受到伤害的僵尸（伤害在下一轮监控开始时统一结算）
+    void queueDamage(ZombieInstance *zombie);
+    // 登记开始受击闪烁的僵尸；每帧绘制前由 updateHitFlashes 推进倒计时
+    void addHitFlash(ZombieInstance *zombie);
+    void updateHitFlashes();
+    // 登记开始带有状态效果的僵尸；每轮监控由 updateStatusEffects 统一推进
+    void addStatusEffectZombie(ZombieInstance *zombie);
+
+    // 在指定行生成僵尸（走ZombieInstanceFactory的正常流程）
+    ZombieInstance *spawnZombie(Zombie *zombie, int row);
 
     // 获取原型对象
     Plant *getPlantProtoType(const QString &eName);
@@ -93,22 +119,53 @@ public:
     ZombieInstance *getZombie(const QUuid &uuid);
     QList<ZombieInstance *> getZombieOnRow(int row);
     QList<ZombieInstance *> getZombieOnRowRange(int row, qreal from, qreal to);
+    int getPlantCount() const;
+    int getPlantCount(const QString &eName) const;  // 指定种类的植物数量
+    int getZombieCount() const;
+    int getSunNum() const;
+    int getWaveNum() const;
+    const QList<Plant *> &getSelectedPlants() const;
+
+    // 不经过鼠标操作使用第 index 张卡片种植（与玩家点击的规则相同：冷却完成、阳光足够且格子可种），成功返回 true
+    bool plantCard(int index, int col, int row);
+    // 收集场上所有尚未收集的阳光
+    void collectSuns();
+    // 不经过鼠标操作铲除指定格子最上层的植物，成功返回 true
+    bool shovelPlant(int col, int row);
+    // 第 index 张卡片剩余的冷却时间（毫秒），冷却完成时为 0
+    int getCardCooldown(int index) const;
 
     // 阳光相关
-    QPair<MoviePixmapItem *, std::function<void(bool)> > newSun(int sunNum);
+    MoviePixmapItem *newSun(int sunNum);              // 从对象池取出一个阳光
+    void dropSun(int sunNum);                          // 从天空掉落一个阳光
+    void growSun(PlantInstance *plant, int sunNum);    // 从植物处弹出一个阳光
+    // 自动收集：产出的阳光直接计入，不创建阳光图元（无界面的评估与机器人接口使用）
+    void setAutoCollectSun(bool autoCollect);
+    ProductionScheduler *getProductionScheduler() const;
     // 地形检查
     bool isCrater(int col, int row) const;
     bool isTombstone(int col, int row) const;
+    // 植物能否种在格子上：查询按植物原型缓存的可种植位图，与 canGrow 的结果相同
+    bool canPlace(const Plant *plant, int col, int row);
+    // 植物原型的可种植位图，第 (row - 1) * 9 + (col - 1) 位表示第 row 行第 col 列
+    quint64 getPlacementMask(const Plant *plant);
+    // 格子中可被啃食的植物，从最上层（pKind 最大）开始，超出草坪时为空
+    const QVector<PlantInstance *> &getEatTargets(int col, int row) const;
     // 获取坐标系统
     Coordinate &getCoordinate();
 
     // 添加触发器
     void addTrigger(int row, Trigger *trigger);
 
+    // 设置监控耗时回调（参数为单次监控的纳秒数，未设置时不计时）
+    void setTickObserver(std::function<void(qint64)> observer);
+
 protected:
     // 游戏流程控制
     void letsGo();
     void doCoolTime(int index);
+    // 按游戏时间推进卡片冷却进度（每轮监控调用）
+    void updateCardCooldowns();
     // 更新工具提示
     void updateTooltip(int index);
     // 更新阳光数量显示
@@ -124,8 +181,12 @@ protected:
     // 鼠标事件处理
     void mouseMoveEvent(QGraphicsSceneMouseEvent *mouseEvent);
     void mousePressEvent(QGraphicsSceneMouseEvent *mouseEvent);
+    // 键盘事件处理（F3 开关性能面板）
+    void keyPressEvent(QKeyEvent *keyEvent);
 
 signals:
+    // 游戏结束（胜利或失败）
+    void gameFinished(bool won);
     // 鼠标事件信号
     void mouseMove(QGraphicsSceneMouseEvent *mouseEvent);
     void mousePress(QGraphicsSceneMouseEvent *mouseEvent);
@@ -169,14 +230,12 @@ private:
 
     // 游戏卡片相关
     QList<Plant *> selectedPlantArray;  // 已选植物数组
-    struct CardGraphicsItem {
-        PlantCardItem *plantCard;  // 植物卡片
-        TooltipItem *tooltip;      // 工具提示
-    };
-    QList<CardGraphicsItem > cardGraphics;  // 卡片图形项
+    SeedBankItem *seedBank;                 // 卡片栏（游戏开始后创建）
+    QList<TooltipItem *> cardTooltips;      // 各卡片的工具提示
     struct CardReadyItem {
         bool cool;  // 是否冷却
         bool sun;   // 是否有足够阳光
+        qint64 coolUntil;  // 冷却结束的时刻（毫秒，见 gameTime）
     };
     QList<CardReadyItem> cardReady;  // 卡片准备状态
 
@@ -185,7 +244,16 @@ private:
     QList<ZombieInstance *> zombieInstances; // 僵尸实例
     QMap<QPair<int, int>, QMap<int, PlantInstance *> > plantPosition; // 植物位置
     QList<QPair<int, int> > craters, tombstones; // 弹坑和墓碑位置
+    // 各植物原型的可种植位图（首次查询时逐格计算，此后只在格子中的植物、弹坑或墓碑变化时更新该格）
+    QHash<const Plant *, quint64> placementMasks;
+    void updatePlacement(int col, int row);  // 重新计算各位图中该格的位
+    // 各格子可被啃食的植物（按 pKind 从大到小），只在格子中的植物变化时更新
+    QVector<QVector<PlantInstance *> > eatTargets;
+    int cellIndex(int col, int row) const;
+    void updateEatTargets(int col, int row);
+    void updateCell(int col, int row);       // 格子中的植物变化后更新可种植位图与可被啃食的植物
     QList<QList<Trigger *> > plantTriggers; // 植物触发器
+    QVector<quint32> triggerEpochs;         // 各行触发区域的版本（新增触发区域时递增）
     QList<QList<ZombieInstance *> > zombieRow; // 僵尸行数组
     QMap<QUuid, PlantInstance *> plantUuid;    // 植物UUID映射
     QMap<QUuid, ZombieInstance *> zombieUuid;  // 僵尸UUID映射
@@ -193,8 +261,73 @@ private:
     // 游戏状态变量
     int choose;      // 当前选择
     int sunNum;      // 阳光数量
-    QTimer *waveTimer, *monitorTimer; // 波次计时器和监控计时器
+    Timer *waveTimer;       // 波次计时器
+    QTimer *monitorTimer;   // 监控计时器（游戏结束后为空）
+    ProductionScheduler *productionScheduler;  // 阳光等资源的生产调度
     int waveNum;     // 当前波次数
+
+    // 模拟与绘制的分界：每轮监控结束时发布僵尸位置等快照，绘制端每帧取最新快照设置图元
+    TripleBuffer<RenderSnapshot> snapshots;
+    qint64 tickCount;       // 已执行的监控轮数
+    QTimer *renderTimer;    // 绘制端的帧计时器（虚拟时钟下不使用）
+    // 绘制端插值：新快照到达后，图元在最近两份快照的间隔内从当时显示的位置平滑移动到快照中的位置
+    QElapsedTimer renderClock;
+    qint64 renderArrival;   // 当前快照到达的时刻（renderClock），尚无快照时为 -1
+    qint64 renderDuration;  // 插值用时（毫秒），为 0 时直接设置
+    QVector<qreal> renderFrom;  // 与当前快照的僵尸一一对应的插值起点
+    bool renderSettled;     // 当前快照已插值完成，到下一份快照之前不再设置图元
+    void publishSnapshot();
+    void renderSnapshot();
+    MoviePixmapItem *zombiePicture(const RenderSnapshot::ZombieState &zombie) const;
+    bool canPlantCard(int index, int col, int row);  // 冷却完成、阳光足够且格子可种
+
+    void applyDamage();          // 结算本轮累计的伤害
+    void updateStatusEffects();  // 推进所有僵尸的状态效果，效果全部结束的僵尸移出列表
+    void updatePlantCooldowns(); // 推进所有植物的攻击冷却（僵尸的冷却在 checkActs 中推进）
+    bool needsTriggerCheck(ZombieInstance *zombie, const QList<Trigger *> &triggers) const;  // 僵尸是否可能位于本行的触发区域中
+    void monitorTickSerial();    // 未开启线程池时的触发器检测与僵尸行为
+    void monitorTickParallel();  // 开启线程池时的触发器检测与僵尸行为
+    void reclaimDead();          // 释放已死亡的实体（每轮监控结束时与场景析构时调用）
+    void monitorTimeout();       // 监控计时器到点：计时并执行一轮监控
+    void scheduleMonitor();      // 虚拟时钟下预约下一轮监控
+    void growPlant(int index, int col, int row);  // 种下第 index 张卡片的植物并开始冷却、扣除阳光
+
+    // 场上的阳光：图元在收集或消失后放回对象池重复使用，存在时间按监控轮数计
+    struct SunState {
+        int sunNum;
+        int expireTicks;    // 落地后剩余的轮数，未落地时为 -1
+        bool collected;     // 正在飞向阳光数值框或淡出，不能再收集
+    };
+    void sunLanded(MoviePixmapItem *sunGif);
+    void collectSun(MoviePixmapItem *sunGif);
+    void releaseSun(MoviePixmapItem *sunGif);
+    void creditSun(int sunNum);
+    void updateSuns();
+    QHash<MoviePixmapItem *, SunState> suns;
+    QList<MoviePixmapItem *> sunPool;
+    bool autoCollectSun;
+
+    // 预览僵尸分帧创建：待创建的动画路径与中心位置
+    void createPreviewZombies();
+    QList<QPair<QString, QPointF> > pendingPreviewZombies;
+    bool previewZombiesStarted;  // 预览僵尸动画是否已开始播放（之后创建的立即播放）
+
+    QList<ZombieInstance *> damagedZombies;    // 本轮受到伤害、尚未结算的僵尸
+    QList<ZombieInstance *> hitFlashZombies;   // 正在受击闪烁的僵尸
+    QList<ZombieInstance *> statusEffectZombies; // 带有状态效果的僵尸
+    QElapsedTimer hitFlashClock;               // 上次推进闪烁倒计时以来的时间
+
+    // 已死亡、等待本轮结束时释放的实体（触发区域随植物一起释放）
+    QList<PlantInstance *> deadPlants;
+    QList<ZombieInstance *> deadZombies;
+    QList<Bullet *> deadBullets;
+    QList<Trigger *> deadTriggers;
+    QSet<int> dirtyZombieRows, dirtyTriggerRows;  // 有待移出的死亡僵尸/触发区域的行
+    QList<MoviePixmapItem *> picturePool;
+    QList<QGraphicsPixmapItem *> bulletPicturePool;
+
+    std::function<void(qint64)> tickObserver;  // 监控耗时回调
+    PerfHud *perfHud;                          // 性能面板（未打开时为空）
 };
 
 #endif //PLANTS_VS_ZOMBIES_GAMESCENE_H
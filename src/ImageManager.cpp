@@ -1,18 +1,137 @@
 // 图像管理器类的实现文件，负责图像的加载和缓存管理
 
 #include "ImageManager.h"
+#include "TraceRecorder.h"
 
 // 全局图像管理器指针
 ImageManager *gImageCache;
 
+// 每帧用于把 QImage 转换为 QPixmap 的时间预算（毫秒）
+static const int ConvertBudget = 4;
+
+/**
+ * @brief 图片解码任务：在线程池中解码一张图片，完成后把结果投递回GUI线程
+ */
+class ImageDecodeTask: public QRunnable
+{
+public:
+    ImageDecodeTask(const QString &path, const QSharedPointer<ImageManager *> &owner)
+            : path(path), owner(owner)
+    {}
+
+    void run() override
+    {
+        QImage image;
+        {
+            TRACE_SCOPE_DETAIL("decode", "ImageDecodeTask", path);
+            image.load(":/images/" + path);
+        }
+        QString decodedPath = path;
+        QSharedPointer<ImageManager *> manager = owner;
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [decodedPath, manager, image] {
+            if (*manager)
+                (*manager)->imageDecoded(decodedPath, image);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    QString path;
+    QSharedPointer<ImageManager *> owner;
+};
+
+ImageManager::ImageManager()
+        : convertTimer(nullptr), self(new ImageManager *(this))
+{}
+
+ImageManager::~ImageManager()
+{
+    *self = nullptr;
+    delete convertTimer;
+}
+
 // 加载图像，如果图像未缓存则加载并缓存
 QPixmap ImageManager::load(const QString &path)
 {
-    if (pixmaps.find(path) == pixmaps.end())
+    if (pixmaps.find(path) == pixmaps.end()) {
+        TRACE_SCOPE_DETAIL("decode", "ImageManager::load", path);
         pixmaps.insert(path, QPixmap(":/images/" + path));
+    }
     return pixmaps[path];
 }
 
+QSize ImageManager::imageSize(const QString &path)
+{
+    auto iter = pixmaps.find(path);
+    if (iter != pixmaps.end())
+        return iter->size();
+    auto sizeIter = sizes.find(path);
+    if (sizeIter == sizes.end()) {
+        QSize size = QImageReader(":/images/" + path).size();
+        // 个别格式无法只从文件头得到尺寸，退回完整加载
+        if (!size.isValid())
+            size = load(path).size();
+        sizeIter = sizes.insert(path, size);
+    }
+    return *sizeIter;
+}
+
+void ImageManager::prefetch(const QStringList &paths)
+{
+    for (const QString &path: paths) {
+        if (path.isEmpty() || pixmaps.contains(path) || decoding.contains(path) || !QFile::exists(":/images/" + path))
+            continue;
+        decoding.insert(path);
+        QThreadPool::globalInstance()->start(new ImageDecodeTask(path, self));
+    }
+}
+
+bool ImageManager::isPrefetching() const
+{
+    return !decoding.isEmpty();
+}
+
+void ImageManager::imageDecoded(const QString &path, const QImage &image)
+{
+    decoded.enqueue(qMakePair(path, image));
+    if (!convertTimer) {
+        convertTimer = new QTimer;
+        convertTimer->setInterval(16);
+        QObject::connect(convertTimer, &QTimer::timeout, [this] { convertDecoded(); });
+    }
+    if (!convertTimer->isActive())
+        convertTimer->start();
+}
+
+// 在时间预算内把若干张解码好的图片转换为 QPixmap，避免单帧卡顿
+void ImageManager::convertDecoded()
+{
+    TRACE_SCOPE("decode", "ImageManager::convertDecoded");
+    QElapsedTimer elapsed;
+    elapsed.start();
+    while (!decoded.isEmpty() && elapsed.elapsed() < ConvertBudget) {
+        QPair<QString, QImage> item = decoded.dequeue();
+        decoding.remove(item.first);
+        // 预取完成前已被同步加载的图片不再重复转换
+        if (!pixmaps.contains(item.first))
+            pixmaps.insert(item.first, QPixmap::fromImage(item.second));
+    }
+    if (decoded.isEmpty())
+        convertTimer->stop();
+}
+
+int ImageManager::cacheCount() const
+{
+    return pixmaps.size();
+}
+
+qint64 ImageManager::cacheBytes() const
+{
+    qint64 bytes = 0;
+    for (const QPixmap &pixmap: pixmaps)
+        bytes += qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+    return bytes;
+}
+
 // 初始化图像管理器
 void InitImageManager()
 {
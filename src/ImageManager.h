@@ -7,10 +7,35 @@
 class ImageManager
 {
 public:
+    ImageManager();
+    ~ImageManager();
+
     QPixmap load(const QString &path);
+    // 图片尺寸：已缓存时直接取缓存，否则只读取文件头，不解码像素
+    QSize imageSize(const QString &path);
+
+    // 预取：在线程池中把图片解码为 QImage，再在GUI线程分帧转换为 QPixmap 放入缓存；
+    // 已缓存、正在解码或不存在的图片会被跳过，预取完成前调用 load 仍会同步加载
+    void prefetch(const QStringList &paths);
+    bool isPrefetching() const;
+
+    // 缓存的图片数量与按像素估算的占用字节数
+    int cacheCount() const;
+    qint64 cacheBytes() const;
 
 private:
+    friend class ImageDecodeTask;
+
+    void imageDecoded(const QString &path, const QImage &image);
+    void convertDecoded();
+
     QMap<QString, QPixmap> pixmaps;
+    QMap<QString, QSize> sizes;
+    QSet<QString> decoding;                    // 已提交解码、尚未放入缓存的图片
+    QQueue<QPair<QString, QImage> > decoded;   // 解码完成、等待转换的图片
+    QTimer *convertTimer;                      // 首次预取时创建
+    // 指向自身，析构时置空；解码任务通过它判断管理器是否仍然存在（只在GUI线程读写）
+    QSharedPointer<ImageManager *> self;
 };
 
 extern ImageManager *gImageCache;
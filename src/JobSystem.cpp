@@ -0,0 +1,146 @@
+// 工作窃取线程池的实现文件
+
+#include "JobSystem.h"
+#include "TraceRecorder.h"
+
+JobSystem *gJobSystem = nullptr;
+
+class JobSystem::Worker: public QThread
+{
+public:
+    Worker(JobSystem *jobSystem, int index)
+            : jobSystem(jobSystem), index(index)
+    {}
+
+protected:
+    void run() override
+    {
+        jobSystem->workerLoop(index);
+    }
+
+private:
+    JobSystem *jobSystem;
+    int index;
+};
+
+JobSystem::JobSystem(int threadCount)
+        : queued(0), quitting(false)
+{
+    for (int i = 0; i <= threadCount; ++i)
+        queues.push_back(new Queue);
+    for (int i = 0; i < threadCount; ++i) {
+        workers.push_back(new Worker(this, i));
+        workers.back()->start();
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    sleepMutex.lock();
+    quitting = true;
+    wakeUp.wakeAll();
+    sleepMutex.unlock();
+    for (QThread *worker: workers) {
+        worker->wait();
+        delete worker;
+    }
+    qDeleteAll(queues);
+}
+
+int JobSystem::threadCount() const
+{
+    return workers.size();
+}
+
+void JobSystem::push(int queue, std::function<void(void)> task)
+{
+    queued.ref();
+    QMutexLocker locker(&queues[queue]->mutex);
+    queues[queue]->tasks.push_back(std::move(task));
+}
+
+// 先从自己的队尾取任务，再依次从其他队列的队首窃取
+bool JobSystem::popOrSteal(int self, std::function<void(void)> &task)
+{
+    {
+        Queue *queue = queues[self];
+        QMutexLocker locker(&queue->mutex);
+        if (!queue->tasks.empty()) {
+            task = std::move(queue->tasks.back());
+            queue->tasks.pop_back();
+            queued.deref();
+            return true;
+        }
+    }
+    for (int i = 1; i < queues.size(); ++i) {
+        Queue *victim = queues[(self + i) % queues.size()];
+        QMutexLocker locker(&victim->mutex);
+        if (!victim->tasks.empty()) {
+            task = std::move(victim->tasks.front());
+            victim->tasks.pop_front();
+            queued.deref();
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::workerLoop(int self)
+{
+    std::function<void(void)> task;
+    forever {
+        if (popOrSteal(self, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+        QMutexLocker locker(&sleepMutex);
+        while (queued.load() == 0 && !quitting)
+            wakeUp.wait(&sleepMutex);
+        if (quitting)
+            return;
+    }
+}
+
+void JobSystem::parallelFor(int count, const std::function<void(int)> &body)
+{
+    if (count <= 0)
+        return;
+    TRACE_SCOPE("sim", "JobSystem::parallelFor");
+    int caller = queues.size() - 1;
+    QAtomicInt remaining(count);
+    // 任务轮流放入各个队列，负载不均时由空闲线程窃取
+    for (int i = 0; i < count; ++i) {
+        push(i % queues.size(), [&body, &remaining, i] {
+            body(i);
+            remaining.deref();
+        });
+    }
+    {
+        QMutexLocker locker(&sleepMutex);
+        wakeUp.wakeAll();
+    }
+
+    // 调用线程同样取任务执行；拿不到任务时说明剩下的都在其他线程中运行，等待其结束
+    std::function<void(void)> task;
+    while (remaining.loadAcquire() > 0) {
+        if (popOrSteal(caller, task)) {
+            task();
+            task = nullptr;
+        }
+        else
+            QThread::yieldCurrentThread();
+    }
+}
+
+void InitJobSystem(int threadCount)
+{
+    if (!gJobSystem && threadCount > 0)
+        gJobSystem = new JobSystem(threadCount);
+}
+
+void DestroyJobSystem()
+{
+    delete gJobSystem;
+    gJobSystem = nullptr;
+}
@@ -0,0 +1,53 @@
+#ifndef PLANTS_VS_ZOMBIES_JOBSYSTEM_H
+#define PLANTS_VS_ZOMBIES_JOBSYSTEM_H
+
+#include <QtCore>
+#include <deque>
+#include <functional>
+
+/**
+ * @brief 工作窃取线程池
+ *
+ * 每个工作线程（以及发起任务的调用线程）各有一个任务队列：自己从队尾取任务，空闲时从其他队列的队首窃取。
+ * 只在命令行指定 --jobs 时存在（gJobSystem 非空），否则各处按原来的单线程流程执行。
+ * 任务只能读取游戏对象或写入各自独占的结果槽，修改场景的工作留给调用线程在合并阶段按固定顺序完成，
+ * 因此结果与单线程运行完全一致
+ */
+class JobSystem
+{
+public:
+    explicit JobSystem(int threadCount);
+    ~JobSystem();
+
+    int threadCount() const;
+
+    // 并行执行 body(0) .. body(count - 1)，调用线程也参与执行，全部完成后返回
+    void parallelFor(int count, const std::function<void(int)> &body);
+
+private:
+    class Worker;
+
+    struct Queue {
+        QMutex mutex;
+        std::deque<std::function<void(void)> > tasks;
+    };
+
+    void push(int queue, std::function<void(void)> task);
+    bool popOrSteal(int self, std::function<void(void)> &task);
+    void workerLoop(int self);
+
+    QVector<Queue *> queues;        // 0 .. threadCount-1 属于工作线程，最后一个属于调用线程
+    QVector<QThread *> workers;
+    QAtomicInt queued;              // 所有队列中尚未取出的任务数
+    QMutex sleepMutex;
+    QWaitCondition wakeUp;
+    bool quitting;
+};
+
+extern JobSystem *gJobSystem;
+
+// threadCount <= 0 时不创建线程池
+void InitJobSystem(int threadCount);
+void DestroyJobSystem();
+
+#endif //PLANTS_VS_ZOMBIES_JOBSYSTEM_H
@@ -5,6 +5,10 @@
 #include "SelectorScene.h"
 #include "GameScene.h"
 #include "AspectRatioLayout.h"
+#include "PerfMonitor.h"
+#include "TraceRecorder.h"
+#include "ObjectCounter.h"
+#include "StartupReport.h"
 
 // 全局主视图指针
 MainView *gMainView;
@@ -74,8 +78,16 @@ void MainView::switchToScene(QGraphicsScene *scene)
     if (this->scene())
         oldScene = this->scene();
     setScene(scene);
-    if (oldScene)
+    if (oldScene) {
+        // 关卡场景析构后，等其子对象的 deleteLater 处理完，再与基线比较生成泄漏报告
+        if (GameScene *gameScene = qobject_cast<GameScene *>(oldScene)) {
+            QString title = gameScene->getGameLevelData()->cName + " exited";
+            connect(oldScene, &QObject::destroyed, [title] {
+                QTimer::singleShot(0, [title] { ObjectCounter::writeLeakReport(title); });
+            });
+        }
         oldScene->deleteLater();
+    }
 }
 
 // 处理主视图的尺寸调整事件
@@ -89,6 +101,52 @@ void MainView::resizeEvent(QResizeEvent *event)
     setTransform(trans);
 }
 
+// 设置帧绘制耗时回调
+void MainView::setFrameObserver(std::function<void(qint64)> observer)
+{
+    frameObserver = observer;
+}
+
+// 登记下一帧之后执行的工作
+void MainView::runAfterNextFrame(std::function<void(void)> functor)
+{
+    afterFrameFunctors.push_back(functor);
+    viewport()->update();
+}
+
+// 绘制场景，设置了回调时统计单帧耗时
+void MainView::paintEvent(QPaintEvent *event)
+{
+    {
+        PerfScope scope(PerfMonitor::Painting);
+        TRACE_SCOPE("render", "MainView::paint");
+        // 受击闪烁随绘制推进
+        if (GameScene *gameScene = qobject_cast<GameScene *>(scene()))
+            gameScene->updateHitFlashes();
+        if (!frameObserver)
+            QGraphicsView::paintEvent(event);
+        else {
+            QElapsedTimer elapsed;
+            elapsed.start();
+            QGraphicsView::paintEvent(event);
+            frameObserver(elapsed.nsecsElapsed());
+        }
+    }
+    if (gPerfMonitor)
+        gPerfMonitor->frameFinished();
+    if (gStartupReport)
+        gStartupReport->frameFinished();
+    // 绘制结果在 paintEvent 返回后才提交到窗口，延后的工作放到下一轮事件循环中执行
+    if (!afterFrameFunctors.isEmpty()) {
+        QList<std::function<void(void)> > functors;
+        functors.swap(afterFrameFunctors);
+        QTimer::singleShot(0, this, [functors] {
+            for (const auto &functor: functors)
+                functor();
+        });
+    }
+}
+
 // 主窗口构造函数，初始化主窗口的布局、全屏操作和背景颜色
 MainWindow::MainWindow()
     : fullScreenSettingEntry("UI/FullScreen"),
@@ -29,15 +29,23 @@ public:
     // 场景管理
     void switchToScene(QGraphicsScene *scene);  // 切换当前显示的场景
 
+    // 设置帧绘制耗时回调（参数为单帧绘制的纳秒数，未设置时不计时）
+    void setFrameObserver(std::function<void(qint64)> observer);
+    // 在下一帧绘制完成（并已显示）之后执行，用于把不影响首帧的加载工作延后
+    void runAfterNextFrame(std::function<void(void)> functor);
+
 protected:
     // 重写父类事件处理
     virtual void resizeEvent(QResizeEvent *event) override;  // 窗口大小调整事件处理
+    virtual void paintEvent(QPaintEvent *event) override;    // 场景绘制事件处理
 
 private:
     const int width, height;           // 视图固定尺寸
     const QString usernameSettingEntry; // 用户名配置项键名
 
     MainWindow *mainWindow;  // 指向主窗口的指针
+    std::function<void(qint64)> frameObserver;  // 帧绘制耗时回调
+    QList<std::function<void(void)> > afterFrameFunctors;  // 等待下一帧完成后执行的工作
 };
 
 /**
@@ -1,6 +1,9 @@
 // 鼠标事件图形项类的实现文件，负责处理鼠标事件和图形项的交互
 
 #include "MouseEventPixmapItem.h"
+#include "PerfMonitor.h"
+#include "TraceRecorder.h"
+#include "ObjectCounter.h"
 
 // 鼠标事件矩形项构造函数，启用悬停事件
 MouseEventRectItem::MouseEventRectItem()
@@ -88,17 +91,21 @@ HoverChangedPixmapItem::HoverChangedPixmapItem(const QPixmap &image) : origImage
 MoviePixmapItem::MoviePixmapItem(const QString &filename)
         : movie(nullptr)
 {
+    OBJECT_COUNTER_INC("MoviePixmapItem");
     setMovie(filename);
 }
 
 // 电影像素图项构造函数，默认构造
 MoviePixmapItem::MoviePixmapItem()
         : movie(nullptr)
-{}
+{
+    OBJECT_COUNTER_INC("MoviePixmapItem");
+}
 
 // 电影像素图项析构函数，释放电影资源
 MoviePixmapItem::~MoviePixmapItem()
 {
+    OBJECT_COUNTER_DEC("MoviePixmapItem");
     if (movie) {
         if (movie->state() == QMovie::Running)
             movie->stop();
@@ -109,14 +116,17 @@ MoviePixmapItem::~MoviePixmapItem()
 // 设置电影，根据文件名加载电影并连接帧变化和结束信号
 void MoviePixmapItem::setMovie(const QString &filename)
 {
+    TRACE_SCOPE_DETAIL("decode", "MoviePixmapItem::setMovie", filename);
     if (movie) {
         movie->stop();
         delete movie;
     }
-    movie = new QMovie(":/images/" + filename);
+    movie = new QMovie(":/images/" + filename, QByteArray(), this);
     movie->jumpToFrame(0);
     setPixmap(movie->currentPixmap());
     connect(movie, &QMovie::frameChanged, [this](int i){
+        PerfScope scope(PerfMonitor::Animations);
+        TRACE_SCOPE("decode", "QMovie::frameChanged");
         setPixmap(movie->currentPixmap());
         if (i == 0)
             emit loopStarted();
@@ -124,6 +134,17 @@ void MoviePixmapItem::setMovie(const QString &filename)
     connect(movie, &QMovie::finished, [this]{ emit finished(); });
 }
 
+// 释放电影与当前帧，图片项放回对象池后不再占用解码资源
+void MoviePixmapItem::clearMovie()
+{
+    if (movie) {
+        movie->stop();
+        delete movie;
+        movie = nullptr;
+    }
+    setPixmap(QPixmap());
+}
+
 // 开始播放电影
 void MoviePixmapItem::start()
 {
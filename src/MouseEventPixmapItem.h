@@ -86,6 +86,7 @@ public:
     void setMovie(const QString &filename);  // 设置动画文件
     void setMovieOnNewLoop(const QString &filename,
                           std::function<void(void)> functor = [] {}); // 带回调的动画设置
+    void clearMovie();  // 释放动画与当前帧（放回对象池时调用）
 
 protected:
     void mousePressEvent(QGraphicsSceneMouseEvent *event) override;
@@ -0,0 +1,85 @@
+// 对象计数器的实现文件：类型计数注册、基线与泄漏报告
+
+#include "ObjectCounter.h"
+#include "ImageManager.h"
+
+// 注册表：类型名 -> 计数器（计数器分配后从不释放，保证缓存的引用始终有效）
+static QMutex &registryMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+static QMap<QString, QAtomicInt *> &registry()
+{
+    static QMap<QString, QAtomicInt *> counters;
+    return counters;
+}
+
+static QMap<QString, int> baseline;
+
+QAtomicInt &ObjectCounter::counter(const char *type)
+{
+    QMutexLocker locker(&registryMutex());
+    QAtomicInt *&counter = registry()[QString::fromLatin1(type)];
+    if (!counter)
+        counter = new QAtomicInt(0);
+    return *counter;
+}
+
+int ObjectCounter::value(const char *type)
+{
+    return counter(type).load();
+}
+
+QMap<QString, int> ObjectCounter::snapshot()
+{
+    QMutexLocker locker(&registryMutex());
+    QMap<QString, int> result;
+    for (auto iter = registry().begin(); iter != registry().end(); ++iter)
+        result.insert(iter.key(), iter.value()->load());
+    return result;
+}
+
+void ObjectCounter::setBaseline()
+{
+    baseline = snapshot();
+}
+
+QString ObjectCounter::reportPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/leak-report.txt";
+}
+
+void ObjectCounter::writeLeakReport(const QString &title)
+{
+    QMap<QString, int> current = snapshot();
+
+    QString report;
+    QTextStream out(&report);
+    out << "== " << QDateTime::currentDateTime().toString(Qt::ISODate) << "  " << title << " ==\n";
+    if (gImageCache)
+        out << QString("ImageManager: %1 images, %2 KB\n")
+                .arg(gImageCache->cacheCount()).arg(gImageCache->cacheBytes() / 1024);
+    out << QString("%1 %2 %3 %4\n").arg("type", -24).arg("live", 8).arg("baseline", 8).arg("delta", 8);
+
+    QStringList leaked;
+    for (auto iter = current.begin(); iter != current.end(); ++iter) {
+        int before = baseline.value(iter.key()), delta = iter.value() - before;
+        out << QString("%1 %2 %3 %4%5\n").arg(iter.key(), -24).arg(iter.value(), 8).arg(before, 8)
+                .arg(delta, 8).arg(delta > 0 ? "  <- leaked" : "");
+        if (delta > 0)
+            leaked << QString("%1 +%2").arg(iter.key()).arg(delta);
+    }
+    out << "\n";
+    out.flush();
+
+    QDir().mkpath(QFileInfo(reportPath()).absolutePath());
+    QFile file(reportPath());
+    if (file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+        file.write(report.toUtf8());
+    if (!leaked.isEmpty())
+        qWarning().noquote() << "Objects survived" << title << ":" << leaked.join(", ") << "(see" << reportPath() << ")";
+
+    baseline = current;
+}
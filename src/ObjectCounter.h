@@ -0,0 +1,35 @@
+#ifndef PLANTS_VS_ZOMBIES_OBJECTCOUNTER_H
+#define PLANTS_VS_ZOMBIES_OBJECTCOUNTER_H
+
+#include <QtCore>
+
+/**
+ * @brief 按类型统计存活对象数量
+ *
+ * 各类型在构造/析构时通过 OBJECT_COUNTER_INC/DEC 增减计数，计数器在首次使用时注册并缓存在局部静态变量中，
+ * 之后每次增减只是一次原子操作。场景退出后与基线比较，生成泄漏报告
+ */
+class ObjectCounter
+{
+public:
+    // 取得（必要时注册）指定类型的计数器，返回的引用在程序运行期间一直有效
+    static QAtomicInt &counter(const char *type);
+    // 指定类型当前的存活数量
+    static int value(const char *type);
+    // 所有类型当前的存活数量
+    static QMap<QString, int> snapshot();
+
+    // 以当前计数作为基线
+    static void setBaseline();
+    // 把当前计数与基线的差异（以及图片缓存占用）追加写入报告文件，并以当前计数作为新基线
+    static void writeLeakReport(const QString &title);
+    // 报告文件路径
+    static QString reportPath();
+};
+
+#define OBJECT_COUNTER_INC(type) \
+    do { static QAtomicInt &objectCounter = ObjectCounter::counter(type); objectCounter.ref(); } while (0)
+#define OBJECT_COUNTER_DEC(type) \
+    do { static QAtomicInt &objectCounter = ObjectCounter::counter(type); objectCounter.deref(); } while (0)
+
+#endif //PLANTS_VS_ZOMBIES_OBJECTCOUNTER_H
@@ -0,0 +1,74 @@
+// 性能面板的实现文件：定时刷新 PerfMonitor 的统计结果与场景中的对象数量
+
+#include "PerfHud.h"
+#include "PerfMonitor.h"
+#include "GameScene.h"
+#include "ObjectCounter.h"
+#include "Timer.h"
+
+PerfHud::PerfHud(GameScene *scene)
+        : scene(scene),
+          text(new QGraphicsSimpleTextItem),
+          refreshTimer(new QTimer(this))
+{
+    setBrush(QColor::fromRgb(0, 0, 0, 180));
+    setPen(Qt::NoPen);
+    setZValue(10);  // 位于所有游戏元素与对话框之上
+    setPos(5, 40);
+
+    QFont font("Consolas", 9);
+    font.setStyleHint(QFont::Monospace);
+    text->setFont(font);
+    text->setBrush(Qt::white);
+    text->setPos(6, 4);
+    text->setParentItem(this);
+
+    connect(refreshTimer, &QTimer::timeout, [this] { refresh(); });
+    refreshTimer->start(500);
+    refresh();
+}
+
+void PerfHud::refresh()
+{
+    if (!gPerfMonitor)
+        return;
+    PerfMonitor::Window window = gPerfMonitor->takeWindow();
+
+    // 存活对象数：场景的子对象以及兼具 QObject 身份的图形项（连同其子对象）
+    QList<QObject *> objects = scene->findChildren<QObject *>();
+    for (QGraphicsItem *item: scene->items()) {
+        if (QObject *object = dynamic_cast<QObject *>(item))
+            objects += object->findChildren<QObject *>();
+    }
+    int timers = 0, timeLines = 0, movies = 0;
+    for (QObject *object: objects) {
+        if (dynamic_cast<Timer *>(object))
+            ++timers;
+        else if (qobject_cast<QTimeLine *>(object))
+            ++timeLines;
+        else if (qobject_cast<QMovie *>(object))
+            ++movies;
+    }
+
+    static const char *names[PerfMonitor::SubsystemCount] = { "monitor", "bullets", "anim", "paint", "audio" };
+    QString split;
+    for (int i = 0; i < PerfMonitor::SubsystemCount; ++i)
+        split += QString("%1 %2%  ").arg(names[i]).arg(window.elapsed ? 100.0 * window.totals[i] / window.elapsed : 0.0, 0, 'f', 1);
+
+    text->setText(QString("frame  p50 %1ms  p99 %2ms  (%3 fps)\n"
+                          "tick   p50 %4ms  p99 %5ms\n"
+                          "%6\n"
+                          "plants %7  zombies %8  bullets %9\n"
+                          "Timers %10  TimeLines %11  QMovies %12")
+                          .arg(gPerfMonitor->framePercentile(0.5), 0, 'f', 1)
+                          .arg(gPerfMonitor->framePercentile(0.99), 0, 'f', 1)
+                          .arg(window.elapsed ? window.frames * 1e9 / window.elapsed : 0.0, 0, 'f', 0)
+                          .arg(gPerfMonitor->tickPercentile(0.5), 0, 'f', 2)
+                          .arg(gPerfMonitor->tickPercentile(0.99), 0, 'f', 2)
+                          .arg(split.trimmed())
+                          .arg(scene->getPlantCount())
+                          .arg(scene->getZombieCount())
+                          .arg(ObjectCounter::value("Bullet"))
+                          .arg(timers).arg(timeLines).arg(movies));
+    setRect(QRectF(QPointF(0, 0), text->boundingRect().size() + QSizeF(12, 8)));
+}
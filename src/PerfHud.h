@@ -0,0 +1,28 @@
+#ifndef PLANTS_VS_ZOMBIES_PERFHUD_H
+#define PLANTS_VS_ZOMBIES_PERFHUD_H
+
+#include <QtWidgets>
+
+class GameScene;
+
+/**
+ * @brief 游戏内性能面板（F3 开关）
+ *
+ * 显示帧耗时与监控耗时的 p50/p99、各子系统的耗时占比，
+ * 以及植物、僵尸、子弹、Timer、TimeLine、QMovie 的存活数量
+ */
+class PerfHud: public QObject, public QGraphicsRectItem
+{
+    Q_OBJECT
+public:
+    explicit PerfHud(GameScene *scene);
+
+private:
+    void refresh();
+
+    GameScene *scene;
+    QGraphicsSimpleTextItem *text;
+    QTimer *refreshTimer;
+};
+
+#endif //PLANTS_VS_ZOMBIES_PERFHUD_H
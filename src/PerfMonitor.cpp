@@ -0,0 +1,89 @@
+// 性能统计器的实现文件：子系统耗时累计与帧/监控耗时分位数
+
+#include <algorithm>
+#include "PerfMonitor.h"
+
+PerfMonitor *gPerfMonitor = nullptr;
+
+PerfMonitor::PerfMonitor()
+        : currentScope(nullptr),
+          frameTimes(240), tickTimes(240),
+          windowFrames(0)
+{
+    std::fill(totals, totals + SubsystemCount, 0);
+    windowTimer.start();
+}
+
+void PerfMonitor::addSample(Subsystem subsystem, qint64 nsecs)
+{
+    totals[subsystem] += nsecs;
+}
+
+void PerfMonitor::addTick(qint64 nsecs)
+{
+    tickTimes.push(nsecs);
+}
+
+void PerfMonitor::frameFinished()
+{
+    ++windowFrames;
+    if (lastFrame.isValid())
+        frameTimes.push(lastFrame.nsecsElapsed());
+    lastFrame.start();
+}
+
+qreal PerfMonitor::framePercentile(qreal p) const
+{
+    return frameTimes.percentile(p) / 1e6;
+}
+
+qreal PerfMonitor::tickPercentile(qreal p) const
+{
+    return tickTimes.percentile(p) / 1e6;
+}
+
+PerfMonitor::Window PerfMonitor::takeWindow()
+{
+    Window window;
+    window.elapsed = windowTimer.nsecsElapsed();
+    window.frames = windowFrames;
+    std::copy(totals, totals + SubsystemCount, window.totals);
+
+    windowTimer.start();
+    windowFrames = 0;
+    std::fill(totals, totals + SubsystemCount, 0);
+    return window;
+}
+
+PerfMonitor::Ring::Ring(int capacity)
+        : data(capacity), next(0), size(0)
+{}
+
+void PerfMonitor::Ring::push(qint64 value)
+{
+    data[next] = value;
+    next = (next + 1) % data.size();
+    size = qMin(size + 1, data.size());
+}
+
+qreal PerfMonitor::Ring::percentile(qreal p) const
+{
+    if (size == 0)
+        return 0;
+    QVector<qint64> samples = data.mid(0, size);
+    int k = qBound(0, qRound(p * (size - 1)), size - 1);
+    std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+    return samples[k];
+}
+
+void InitPerfMonitor()
+{
+    if (!gPerfMonitor)
+        gPerfMonitor = new PerfMonitor;
+}
+
+void DestroyPerfMonitor()
+{
+    delete gPerfMonitor;
+    gPerfMonitor = nullptr;
+}
@@ -0,0 +1,113 @@
+#ifndef PLANTS_VS_ZOMBIES_PERFMONITOR_H
+#define PLANTS_VS_ZOMBIES_PERFMONITOR_H
+
+#include <QtCore>
+
+class PerfScope;
+
+/**
+ * @brief 性能统计器
+ *
+ * 按子系统累计耗时，并保存最近若干帧的帧间隔与监控耗时用于计算 p50/p99。
+ * 只在性能面板打开时存在（gPerfMonitor 非空），关闭时各处的 PerfScope 只做一次指针判断
+ */
+class PerfMonitor
+{
+public:
+    // 统计的子系统
+    enum Subsystem {
+        Monitor,     // 监控（触发器检测与僵尸行为）
+        Bullets,     // 子弹移动与命中
+        Animations,  // Animate/TimeLine 关键帧与 GIF 帧切换
+        Painting,    // 场景绘制
+        Audio,       // 音效播放
+        SubsystemCount
+    };
+
+    PerfMonitor();
+
+    // 记录一段子系统耗时（纳秒，已扣除嵌套的其他子系统）
+    void addSample(Subsystem subsystem, qint64 nsecs);
+    // 记录一次监控耗时（包含嵌套子系统的完整耗时）
+    void addTick(qint64 nsecs);
+    // 一帧绘制完成，记录与上一帧的间隔
+    void frameFinished();
+
+    // 帧间隔与监控耗时的分位数（毫秒）
+    qreal framePercentile(qreal p) const;
+    qreal tickPercentile(qreal p) const;
+
+    // 取出当前统计区间的数据并开始新的区间
+    struct Window {
+        qint64 elapsed;                    // 区间时长（纳秒）
+        int frames;                        // 区间内的帧数
+        qint64 totals[SubsystemCount];     // 各子系统累计耗时（纳秒）
+    };
+    Window takeWindow();
+
+    // 当前正在计时的最内层 PerfScope（用于扣除嵌套耗时）
+    PerfScope *currentScope;
+
+private:
+    // 定长环形缓冲区，保存最近的样本
+    class Ring
+    {
+    public:
+        explicit Ring(int capacity);
+        void push(qint64 value);
+        qreal percentile(qreal p) const;
+    private:
+        QVector<qint64> data;
+        int next, size;
+    };
+
+    Ring frameTimes, tickTimes;
+    QElapsedTimer lastFrame, windowTimer;
+    int windowFrames;
+    qint64 totals[SubsystemCount];
+};
+
+extern PerfMonitor *gPerfMonitor;
+
+void InitPerfMonitor();
+void DestroyPerfMonitor();
+
+/**
+ * @brief 子系统计时作用域
+ * 构造时开始计时、析构时把扣除嵌套部分后的耗时记入 gPerfMonitor；未开启统计时不做任何事
+ */
+class PerfScope
+{
+public:
+    explicit PerfScope(PerfMonitor::Subsystem subsystem)
+            : subsystem(subsystem), parent(nullptr), childNsecs(0), active(gPerfMonitor != nullptr)
+    {
+        if (active) {
+            parent = gPerfMonitor->currentScope;
+            gPerfMonitor->currentScope = this;
+            timer.start();
+        }
+    }
+
+    ~PerfScope()
+    {
+        if (!active || !gPerfMonitor)
+            return;
+        qint64 elapsed = timer.nsecsElapsed();
+        gPerfMonitor->currentScope = parent;
+        if (parent)
+            parent->childNsecs += elapsed;
+        gPerfMonitor->addSample(subsystem, elapsed - childNsecs);
+        if (subsystem == PerfMonitor::Monitor)
+            gPerfMonitor->addTick(elapsed);
+    }
+
+private:
+    PerfMonitor::Subsystem subsystem;
+    PerfScope *parent;
+    qint64 childNsecs;
+    bool active;
+    QElapsedTimer timer;
+};
+
+#endif //PLANTS_VS_ZOMBIES_PERFMONITOR_H
@@ -6,6 +6,11 @@
 #include "MouseEventPixmapItem.h"
 #include "Timer.h"
 #include "Animate.h"
+#include "AudioManager.h"
+#include "PerfMonitor.h"
+#include "TraceRecorder.h"
+#include "ObjectCounter.h"
+#include "ProductionScheduler.h"
 
 
 //Plant 类是所有植物类的基类，它定义了植物的基本属性和方法，例如植物的名称、生命值、尺寸、攻击范围、冷却时间等
@@ -17,7 +22,14 @@ Plant::Plant()
           zIndex(0),             // 渲染层级（Z轴顺序）
           canEat(true), canSelect(true), night(false), // 可被吃/可选中/夜间植物标识
           coolTime(7.5), stature(0), sleep(0), scene(nullptr) // 冷却时间/形态/睡眠状态/所属场景
-{}
+{
+    OBJECT_COUNTER_INC("Plant");
+}
+
+Plant::~Plant()
+{
+    OBJECT_COUNTER_DEC("Plant");
+}
 
 // 获取植物X轴偏移量（用于居中显示）
 double Plant::getDX() const
@@ -55,24 +67,30 @@ bool Plant::canGrow(int x, int y) const
 // 更新植物图片尺寸（根据静态图自动获取）
 void Plant::update()
 {
-    QPixmap pic = gImageCache->load(staticGif); // 加载静态图片
-    width = pic.width();  // 更新宽度
-    height = pic.height();// 更新高度
+    QSize size = gImageCache->imageSize(staticGif); // 只读取静态图片的尺寸，不解码
+    width = size.width();  // 更新宽度
+    height = size.height();// 更新高度
 }
 
 // PlantInstance构造函数，初始化植物实例
 PlantInstance::PlantInstance(const Plant *plant) : plantProtoType(plant)
 {
+    OBJECT_COUNTER_INC("PlantInstance");
     uuid = QUuid::createUuid(); // 生成唯一UUID
     hp = plantProtoType->hp;    // 继承原型生命值
     canTrigger = true;          // 初始可触发攻击
-    picture = new MoviePixmapItem; // 创建动画图片项
+    dead = false;
+    instanceIndex = -1;
+    fireState = FireReady;      // 攻击状态机
+    fireTicks = 0;
+    picture = plantProtoType->scene->takePicture(); // 从对象池取得动画图片项
 }
 
-// 析构函数，延迟释放图片资源
+// 析构函数，图片放回对象池
 PlantInstance::~PlantInstance()
 {
-    picture->deleteLater(); // 延迟删除避免渲染冲突
+    OBJECT_COUNTER_DEC("PlantInstance");
+    plantProtoType->scene->releasePicture(picture);
 }
 
 // 植物出生逻辑（种植时调用）
@@ -124,31 +142,42 @@ void PlantInstance::triggerCheck(ZombieInstance *zombieInstance, Trigger *trigge
 {
     if (zombieInstance->altitude > 0) { // 仅处理地面僵尸
         canTrigger = false; // 防止重复触发
-        QSharedPointer<std::function<void(QUuid)> > triggerCheck(new std::function<void(QUuid)>);
-
-        // 递归检查逻辑（处理僵尸移动中的持续触发）
-        *triggerCheck = [this, triggerCheck] (QUuid zombieUuid) {
-            (new Timer(picture, 1400, [this, zombieUuid, triggerCheck] {
-                ZombieInstance *zombie = this->plantProtoType->scene->getZombie(zombieUuid);
-                if (zombie) {
-                    // 遍历当前行触发器，检查僵尸是否仍在范围内
-                    for (auto i: triggers[zombie->row]) {
-                        if (zombie->hp > 0 && i->from <= zombie->ZX && i->to >= zombie->ZX && zombie->altitude > 0) {
-                            normalAttack(zombie); // 执行攻击
-                            (*triggerCheck)(zombie->uuid); // 继续递归检查
-                            return;
-                        }
-                    }
-                }
-                canTrigger = true; // 退出递归时恢复触发状态
-            }))->start();
-        };
-
         normalAttack(zombieInstance); // 首次触发攻击
-        (*triggerCheck)(zombieInstance->uuid); // 启动递归检查
+        // 之后由 updateCooldowns 每 FireInterval 轮检查僵尸是否仍在范围内
+        fireState = FireCooling;
+        fireTicks = FireInterval;
+        fireTarget = zombieInstance->uuid;
     }
 }
 
+void PlantInstance::updateCooldowns()
+{
+    if (fireState != FireCooling || --fireTicks > 0)
+        return;
+    ZombieInstance *zombie = plantProtoType->scene->getZombie(fireTarget);
+    if (zombie) {
+        // 遍历当前行触发器，检查僵尸是否仍在范围内
+        for (auto i: triggers[zombie->row]) {
+            if (zombie->hp > 0 && i->from <= zombie->ZX && i->to >= zombie->ZX && zombie->altitude > 0) {
+                normalAttack(zombie); // 执行攻击
+                fireTicks = FireInterval;
+                return;
+            }
+        }
+    }
+    fireState = FireReady;
+    canTrigger = true; // 僵尸离开后恢复触发状态
+}
+
+// 生产者的显示效果（子类重写，如向日葵发光）
+void PlantInstance::beginProduction()
+{
+}
+
+void PlantInstance::endProduction()
+{
+}
+
 // 普通攻击逻辑（子类重写实现具体攻击）
 void PlantInstance::normalAttack(ZombieInstance *zombieInstance)
 {
@@ -432,7 +461,7 @@ void JalapenoInstance::moveAndExplode()
 
     // 0.5秒后开始移动和爆炸
     (new Timer(picture, 300, [this] {
-        QSound::play(":/audio/jalapeno.wav");
+        AudioManager::play(":/audio/jalapeno.wav");
 
         // 获取整行僵尸（优化后的方式）
         QList<ZombieInstance*> zombies;
@@ -484,7 +513,7 @@ PeashooterInstance::PeashooterInstance(const Plant *plant)
 
 void PeashooterInstance::normalAttack(ZombieInstance *zombieInstance)
 {
-    QSound::play(":/audio/firepea.wav");
+    AudioManager::play(":/audio/firepea.wav");
     (new Bullet(plantProtoType->scene, 0, row, attackedLX, attackedLX - 40, picture->y() + 3, picture->zValue() + 2, 0))->start();
 }
 
@@ -510,7 +539,7 @@ RepeaterInstance::RepeaterInstance(const Plant *plant)
 
 void RepeaterInstance::normalAttack(ZombieInstance *zombieInstance)
 {
-    QSound::play(":/audio/firepea.wav");  // 播放相同射击音效
+    AudioManager::play(":/audio/firepea.wav");  // 播放相同射击音效
 
     // 创建第一颗豌豆（右侧偏移）
     (new Bullet(plantProtoType->scene,
@@ -555,7 +584,7 @@ ThreepeaterInstance::ThreepeaterInstance(const Plant *plant)
 // 攻击逻辑（同时攻击三行）
 void ThreepeaterInstance::normalAttack(ZombieInstance *zombieInstance)
 {
-    QSound::play(":/audio/firepea.wav");
+    AudioManager::play(":/audio/firepea.wav");
 
     // 获取坐标系引用
     Coordinate &coord = plantProtoType->scene->getCoordinate();
@@ -617,7 +646,7 @@ SnowPeaInstance::SnowPeaInstance(const Plant *plant)
 
 void SnowPeaInstance::normalAttack(ZombieInstance *zombieInstance)
 {
-    QSound::play(":/audio/firepea.wav");
+    AudioManager::play(":/audio/firepea.wav");
     (new Bullet(plantProtoType->scene, -1, row, attackedLX, attackedLX - 40, picture->y() + 3, picture->zValue() + 2, 0))->start();
 }
 
@@ -637,64 +666,32 @@ SunFlower::SunFlower()
 // SunFlowerInstance类构造函数 - 向日葵实例初始化
 SunFlowerInstance::SunFlowerInstance(const Plant *plant)
         : PlantInstance(plant),
-          lightedGif("Plants/SunFlower/SunFlower2.gif") // 发光状态动画路径
+          lightedGif("Plants/SunFlower/SunFlower2.gif"), // 发光状态动画路径
+          producer(0)
 {
     // 继承基类初始化，并记录发光动画资源
 }
 
-// 初始化触发器与阳光生成逻辑
+SunFlowerInstance::~SunFlowerInstance()
+{
+    if (producer)
+        plantProtoType->scene->getProductionScheduler()->removeProducer(producer);
+}
+
+// 登记为阳光生产者：种下6秒后第一次产出，之后每25秒一次，产出前1秒开始发光
 void SunFlowerInstance::initTrigger()
 {
-    // 创建定时器：每5秒触发一次阳光生成逻辑
-    (new Timer(picture, 5000, [this] {
-        // 定义阳光生成的递归函数（使用智能指针避免内存泄漏）
-        QSharedPointer<std::function<void(void)> > generateSun(new std::function<void(void)>);
-        *generateSun = [this, generateSun] {
-            // 切换向日葵到发光状态（生成阳光前的动画）
-            picture->setMovieOnNewLoop(lightedGif, [this, generateSun] {
-                // 1秒后执行阳光生成
-                (new Timer(picture, 1000, [this, generateSun] {
-                    // 调用场景方法创建阳光（返回阳光动画与结束回调）
-                    auto sunGifAndOnFinished = plantProtoType->scene->newSun(25);
-                    MoviePixmapItem *sunGif = sunGifAndOnFinished.first;         // 阳光动画对象
-                    std::function<void(bool)> onFinished = sunGifAndOnFinished.second; // 动画结束回调
-
-                    // 获取场景坐标系统
-                    Coordinate &coordinate = plantProtoType->scene->getCoordinate();
-                    // 计算阳光生成的起始与目标位置
-                    double fromX = coordinate.getX(col) - sunGif->boundingRect().width() / 2 + 15,
-                           toX = coordinate.getX(col) - qrand() % 80,           // 随机水平偏移
-                           toY = coordinate.getY(row) - sunGif->boundingRect().height();
-
-                    // 初始化阳光动画：
-                    sunGif->setScale(0.6);              // 初始缩放比例
-                    sunGif->setPos(fromX, toY - 25);     // 初始位置（向日葵上方）
-                    sunGif->start();                    // 启动动画播放
-
-                    // 定义阳光动画轨迹（使用Animate类实现平滑移动）：
-                    Animate(sunGif, plantProtoType->scene)
-                        .move(QPointF((fromX + toX) / 2, toY - 50))  // 第一段移动（向上弧线路径）
-                        .scale(0.9)                                 // 缩放变化
-                        .speed(0.2)                                 // 移动速度
-                        .shape(QTimeLine::EaseOutCurve)              // 缓出曲线（开始快，结束慢）
-                        .finish()                                   // 第一段结束回调（空）
-                        .move(QPointF(toX, toY))                    // 第二段移动（落至目标位置）
-                        .scale(1.0)                                 // 恢复原始大小
-                        .speed(0.2)                                 // 移动速度
-                        .shape(QTimeLine::EaseInCurve)               // 缓入曲线（开始慢，结束快）
-                        .finish(onFinished);                        // 整体结束回调（由场景定义）
-
-                    // 阳光生成后，向日葵恢复正常状态并设置下次生成定时器
-                    picture->setMovieOnNewLoop(plantProtoType->normalGif, [this, generateSun] {
-                        (new Timer(picture, 24000, [this, generateSun] {
-                            (*generateSun)(); // 24秒后再次生成阳光（递归调用）
-                        }))->start();
-                    });
-                }))->start();
-            });
-        };
-        (*generateSun)(); // 立即执行第一次阳光生成
-    }))->start();
+    producer = plantProtoType->scene->getProductionScheduler()->addProducer({ this, 25, 250, 250, 10 }, 60);
+}
+
+void SunFlowerInstance::beginProduction()
+{
+    picture->setMovieOnNewLoop(lightedGif);
+}
+
+void SunFlowerInstance::endProduction()
+{
+    picture->setMovieOnNewLoop(plantProtoType->normalGif);
 }
 // WallNut类 - 坚果墙原型定义
 WallNut::WallNut()
@@ -826,11 +823,13 @@ void LawnCleanerInstance::triggerCheck(ZombieInstance *zombieInstance, Trigger *
 void LawnCleanerInstance::normalAttack(ZombieInstance *zombieInstance)
 {
     // 播放割草机启动音效
-    QSound::play(":/audio/lawnmower.wav");
+    AudioManager::play(":/audio/lawnmower.wav");
 
     // 创建一个递归函数，用于持续清除僵尸并向右移动
     QSharedPointer<std::function<void(void)> > crush(new std::function<void(void)>);
-    *crush = [this, crush] {
+    QWeakPointer<std::function<void(void)> > weakCrush = crush;
+    *crush = [this, weakCrush] {
+        QSharedPointer<std::function<void(void)> > crush = weakCrush.toStrongRef();
         // 获取当前行指定范围内的所有僵尸
         for (auto zombie: plantProtoType->scene->getZombieOnRowRange(row, attackedLX, attackedRX)) {
             // 尝试压碎僵尸（检查是否可以被压碎）
@@ -847,7 +846,7 @@ void LawnCleanerInstance::normalAttack(ZombieInstance *zombieInstance)
             attackedRX += 10;
             picture->setPos(picture->pos() + QPointF(10, 0));  // 更新图片位置
             // 定时继续执行清除逻辑，形成持续移动效果
-            (new Timer(picture, 10, *crush))->start();
+            (new Timer(picture, 10, [crush] { (*crush)(); }))->start();
         }
     };
 
@@ -858,16 +857,19 @@ void LawnCleanerInstance::normalAttack(ZombieInstance *zombieInstance)
 Bullet::Bullet(GameScene *scene, int type, int row, qreal from, qreal x, qreal y, qreal zvalue, int direction)
         : scene(scene), type(type), row(row), direction(direction), from(from)
 {
+    OBJECT_COUNTER_INC("Bullet");
     count = 0;  // 移动计数器，用于控制何时添加到场景
     // 根据子弹类型和方向加载对应的图片资源
-    picture = new QGraphicsPixmapItem(gImageCache->load(QString("Plants/PB%1%2.gif").arg(type).arg(direction)));
+    picture = scene->takeBulletPicture();
+    picture->setPixmap(gImageCache->load(QString("Plants/PB%1%2.gif").arg(type).arg(direction)));
     picture->setPos(x, y);           // 设置初始位置
     picture->setZValue(zvalue);      // 设置渲染层级
 }
 
 Bullet::~Bullet()
 {
-    delete picture;  // 清理图片资源
+    OBJECT_COUNTER_DEC("Bullet");
+    scene->releaseBulletPicture(picture);  // 图片放回对象池
 }
 
 // 启动子弹移动
@@ -882,6 +884,9 @@ void Bullet::start()
 // 子弹移动和碰撞检测逻辑
 void Bullet::move()
 {
+    PerfScope scope(PerfMonitor::Bullets);
+    TRACE_SCOPE("sim", "Bullet::move");
+
     // 延迟5帧后将子弹添加到场景，实现子弹发射动画效果
     if (count++ == 5)
         scene->addItem(picture);
@@ -906,8 +911,8 @@ void Bullet::move()
         QList<ZombieInstance *> zombies = scene->getZombieOnRow(row);
         // 从后向前遍历僵尸列表（离植物最远的僵尸优先）
         for (auto iter = zombies.end(); iter-- != zombies.begin() && (*iter)->attackedLX <= from;) {
-            // 找到第一个生命值大于0且在子弹攻击范围内的僵尸
-            if ((*iter)->hp > 0 && (*iter)->attackedRX >= from) {
+            // 找到第一个生命值大于0（计入本轮尚未结算的伤害）且在子弹攻击范围内的僵尸
+            if ((*iter)->hpAfterPendingDamage() > 0 && (*iter)->attackedRX >= from) {
                 zombie = *iter;
                 break;
             }
@@ -928,9 +933,10 @@ void Bullet::move()
         // 显示子弹击中效果
         picture->setPos(picture->pos() + QPointF(28, 0));  // 调整位置
         picture->setPixmap(gImageCache->load("Plants/PeaBulletHit.gif"));  // 击中动画
-        // 延迟后销毁子弹
+        // 延迟后销毁子弹（本轮监控结束时释放）
         (new Timer(scene, 100, [this] {
-            delete this;
+            picture->setVisible(false);  // 击中效果在延迟结束时立即消失，不等本轮结束
+            scene->bulletDie(this);
         }))->start();
     }
     else {
@@ -945,8 +951,10 @@ void Bullet::move()
                 move();
             }))->start();
         }
-        else
-            delete this;  // 超出范围，销毁子弹
+        else {
+            picture->setVisible(false);
+            scene->bulletDie(this);  // 超出范围，销毁子弹
+        }
     }
 }
 // PumpkinHead类 - 南瓜头原型定义
@@ -999,7 +1007,7 @@ double PumpkinHead::getDY(int x, int y) const
 
 // PumpkinHeadInstance类 - 南瓜头实例
 PumpkinHeadInstance::PumpkinHeadInstance(const Plant *plant)
-    : PlantInstance(plant), picture2(new MoviePixmapItem)
+    : PlantInstance(plant), picture2(plant->scene->takePicture())
 {
     hurtStatus = 0; // 伤害状态（0=正常，1=轻度损坏，2=严重损坏）
 }
@@ -1069,7 +1077,7 @@ void PumpkinHeadInstance::getHurt(ZombieInstance *zombie, int aKind, int attack)
 // 析构函数 - 清理资源
 PumpkinHeadInstance::~PumpkinHeadInstance()
 {
-    picture2->deleteLater();
+    plantProtoType->scene->releasePicture(picture2);
 }
 
 Torchwood::Torchwood()
@@ -16,7 +16,7 @@ class Plant
 
 public:
     Plant();
-    virtual  ~Plant() {}
+    virtual  ~Plant();
 
     QString eName, cName;
     int width, height;
@@ -49,17 +49,30 @@ public:
     virtual void triggerCheck(ZombieInstance *zombieInstance, Trigger *trigger);
     virtual void normalAttack(ZombieInstance *zombieInstance);
     virtual void getHurt(ZombieInstance *zombie, int aKind, int attack);
+    virtual void updateCooldowns();     // 每轮监控推进攻击冷却
+    virtual void beginProduction();     // 资源生产前（ProductionScheduler 的 charging 事件）
+    virtual void endProduction();       // 资源产出时
 
     bool contains(const QPointF &pos);
 
+    // 攻击状态机：FireReady（可被触发）-> FireCooling（每 FireInterval 轮对同一僵尸再攻击一次，
+    // 僵尸离开触发范围或死亡后回到 FireReady）
+    enum FireState { FireReady, FireCooling };
+    static const int FireInterval = 14; // 攻击间隔（轮，即1.4秒）
+
     const Plant *plantProtoType;
 
     QUuid uuid;
     int row, col;
     int hp;
     bool canTrigger;
+    bool dead;              // 已死亡，等待本轮监控结束时释放
+    int instanceIndex;      // 在场景植物实例列表中的下标（用于交换删除）
+    FireState fireState;
+    int fireTicks;          // 距下次攻击的轮数
+    QUuid fireTarget;       // 正在攻击的僵尸
     qreal attackedLX, attackedRX;
-    QMap<int, QList<Trigger *> > triggers;
+    QMap<int, QList<Trigger *> > triggers;  // 本植物注册到场景的触发区域（行 -> 触发区域），死亡时据此注销
 
     QGraphicsPixmapItem *shadowPNG;
     MoviePixmapItem *picture;
@@ -186,9 +199,13 @@ class SunFlowerInstance: public PlantInstance
 {
 public:
     SunFlowerInstance(const Plant *plant);
+    ~SunFlowerInstance();
     virtual void initTrigger();
+    void beginProduction() override;
+    void endProduction() override;
 private:
     QString lightedGif;
+    int producer;   // 在场景的 ProductionScheduler 中的编号
 };
 
 class WallNut: public Plant
@@ -240,9 +257,8 @@ public:
     Bullet(GameScene *scene, int type, int row, qreal from, qreal x, qreal y, qreal zvalue,  int direction);
     ~Bullet();
     void start();
+    void move();   // 单步推进并检测命中（基准测试会直接调用）
 private:
-    void move();
-
     GameScene *scene;
     int count, type, row, direction;
     QUuid uuid;
@@ -4,14 +4,14 @@
 #include "ImageManager.h"
 #include "Plant.h"
 
-// 植物卡片项构造函数，初始化卡片的图像、选中状态和阳光数量显示等
-PlantCardItem::PlantCardItem(const Plant *plant, bool smaller) : checked(true), percent(0), overlayImage(new QGraphicsPixmapItem)
+// 从卡片图中切出可用与不可用两种状态的图像；darken 时把不可用图像加暗，并求出卡片内容的纵向范围
+static void loadCardImages(const Plant *plant, bool darken, QPixmap &checkedImage, QPixmap &uncheckedImage,
+                           int &lowestHeight, int &highestHeight)
 {
-    setCursor(Qt::PointingHandCursor);
     QPixmap image = gImageCache->load(plant->cardGif);
     checkedImage = image.copy(0, 0, image.width(), image.height() / 2);
     uncheckedImage = image.copy(0, image.height() / 2, image.width(), image.height() / 2);
-    if (!smaller) {
+    if (darken) {
         QPainter p(&uncheckedImage);
         p.setBrush(QBrush(QColor::fromRgba(0x80000000)));
         p.setPen(Qt::NoPen);
@@ -22,6 +22,13 @@ PlantCardItem::PlantCardItem(const Plant *plant, bool smaller) : checked(true),
         p.setClipRegion(region);
         p.drawRect(0, 0, uncheckedImage.width(), uncheckedImage.height());
     }
+}
+
+// 植物卡片项构造函数，初始化卡片的图像、选中状态和阳光数量显示等
+PlantCardItem::PlantCardItem(const Plant *plant, bool smaller) : checked(true), percent(0), overlayImage(new QGraphicsPixmapItem)
+{
+    setCursor(Qt::PointingHandCursor);
+    loadCardImages(plant, !smaller, checkedImage, uncheckedImage, lowestHeight, highestHeight);
     setPixmap(checkedImage);
     overlayImage->setVisible(false);
     overlayImage->setOpacity(0.4);
@@ -87,19 +94,168 @@ void PlantCardItem::updatePixmap()
 
 // 工具提示项构造函数，初始化工具提示的文本显示
 TooltipItem::TooltipItem(const QString &text)
-        : tooltipText(new QGraphicsTextItem)
+        : tooltipText(nullptr)
 {
-    tooltipText->setTextWidth(180);
-    tooltipText->setHtml(text);
-    tooltipText->setParentItem(this);
-    setRect(tooltipText->boundingRect());
     setPen(QPen(Qt::black));
     setBrush(QColor::fromRgb(0xf0f0d0));
+    setText(text);
 }
 
-// 设置工具提示的文本
+// 设置工具提示的文本，已排版过的文本直接切换显示
 void TooltipItem::setText(const QString &text)
 {
-    tooltipText->setHtml(text);
+    if (tooltipText && tooltipText == layouts.value(text))
+        return;
+    QGraphicsTextItem *&layout = layouts[text];
+    if (!layout) {
+        layout = new QGraphicsTextItem;
+        layout->setTextWidth(180);
+        layout->setHtml(text);
+        layout->setParentItem(this);
+    }
+    if (tooltipText)
+        tooltipText->setVisible(false);
+    tooltipText = layout;
+    tooltipText->setVisible(true);
     setRect(tooltipText->boundingRect());
 }
+
+// 卡片栏构造函数，准备各卡片的图像与阳光花费文本
+SeedBankItem::SeedBankItem(const QList<Plant *> &plants)
+        : sunNumFont("Times New Roman", 16), hovered(-1)
+{
+    setAcceptHoverEvents(true);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);  // 只重绘露出的卡片
+    for (const Plant *plant: plants) {
+        Card card;
+        loadCardImages(plant, true, card.checkedImage, card.uncheckedImage, card.lowestHeight, card.highestHeight);
+        card.sunNum.setText(QString::number(plant->sunNum));
+        card.sunNum.setTextFormat(Qt::PlainText);
+        card.sunNum.prepare(QTransform(), sunNumFont);
+        QSizeF sunNumSize = card.sunNum.size();
+        card.sunNumPos = QPointF(card.checkedImage.width() - sunNumSize.width() - 4, card.checkedImage.height() - sunNumSize.height());
+        card.checked = false;
+        card.maskHeight = 0;
+        cardSize = cardSize.expandedTo(card.checkedImage.size());
+        cards.push_back(card);
+    }
+}
+
+QRectF SeedBankItem::boundingRect() const
+{
+    if (cards.isEmpty())
+        return QRectF();
+    return QRectF(0, 0, cardSize.width(), CardSpacing * (cards.size() - 1) + cardSize.height());
+}
+
+QRectF SeedBankItem::cardRect(int index) const
+{
+    return QRectF(QPointF(0, CardSpacing * index), cardSize);
+}
+
+// 依次绘制露出的卡片：卡片图像、冷却遮罩（可用图像的下部，透明度0.4）、阳光花费
+void SeedBankItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+    painter->setFont(sunNumFont);
+    painter->setPen(Qt::black);
+    for (int i = 0; i < cards.size(); ++i) {
+        QRectF rect = cardRect(i);
+        if (!rect.intersects(option->exposedRect))
+            continue;
+        const Card &card = cards[i];
+        if (card.checked)
+            painter->drawPixmap(rect.topLeft(), card.checkedImage);
+        else {
+            painter->drawPixmap(rect.topLeft(), card.uncheckedImage);
+            if (card.maskHeight) {
+                int y = card.checkedImage.height() - card.maskHeight;
+                qreal opacity = painter->opacity();
+                painter->setOpacity(opacity * 0.4);
+                painter->drawPixmap(QRectF(rect.left(), rect.top() + y, card.checkedImage.width(), card.maskHeight),
+                                    card.checkedImage, QRectF(0, y, card.checkedImage.width(), card.maskHeight));
+                painter->setOpacity(opacity);
+            }
+        }
+        painter->drawStaticText(rect.topLeft() + card.sunNumPos, card.sunNum);
+    }
+}
+
+int SeedBankItem::count() const
+{
+    return cards.size();
+}
+
+int SeedBankItem::cardAt(const QPointF &scenePos) const
+{
+    QPointF pos = mapFromScene(scenePos);
+    int index = qFloor(pos.y() / CardSpacing);
+    if (index < 0 || index >= cards.size() || !cardRect(index).contains(pos))
+        return -1;
+    return index;
+}
+
+QPointF SeedBankItem::cardScenePos(int index) const
+{
+    return mapToScene(cardRect(index).topLeft());
+}
+
+void SeedBankItem::setChecked(int index, bool checked)
+{
+    Card &card = cards[index];
+    if (card.checked == checked)
+        return;
+    card.checked = checked;
+    if (index == hovered)
+        setCursor(checked ? Qt::PointingHandCursor : Qt::ArrowCursor);
+    update(cardRect(index));
+}
+
+bool SeedBankItem::isChecked(int index) const
+{
+    return cards[index].checked;
+}
+
+// 遮罩高度按像素取整，高度不变时不重绘
+void SeedBankItem::setPercent(int index, double value)
+{
+    Card &card = cards[index];
+    int height = static_cast<int>((card.highestHeight - card.lowestHeight) * value + card.lowestHeight + 0.5);
+    if (height == card.maskHeight)
+        return;
+    card.maskHeight = height;
+    if (!card.checked)
+        update(cardRect(index));
+}
+
+// 鼠标在卡片间移动时，先对原卡片发出离开、再对新卡片发出进入
+void SeedBankItem::setHovered(int index, QGraphicsSceneHoverEvent *event)
+{
+    if (index == hovered)
+        return;
+    if (hovered >= 0)
+        emit hoverLeft(hovered, event);
+    hovered = index;
+    setCursor(hovered >= 0 && cards[hovered].checked ? Qt::PointingHandCursor : Qt::ArrowCursor);
+    if (hovered >= 0)
+        emit hoverEntered(hovered, event);
+}
+
+void SeedBankItem::hoverEnterEvent(QGraphicsSceneHoverEvent *event)
+{
+    setHovered(cardAt(event->scenePos()), event);
+}
+
+void SeedBankItem::hoverMoveEvent(QGraphicsSceneHoverEvent *event)
+{
+    int index = cardAt(event->scenePos());
+    if (index == hovered && index >= 0)
+        emit hoverMoved(index, event);
+    else
+        setHovered(index, event);
+}
+
+void SeedBankItem::hoverLeaveEvent(QGraphicsSceneHoverEvent *event)
+{
+    setHovered(-1, event);
+}
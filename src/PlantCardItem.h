@@ -13,11 +13,13 @@ public:
     // 构造函数，传入提示文本
     TooltipItem(const QString &text);
 
-    // 设置提示文本内容
+    // 设置提示文本内容（与当前文本相同时不做任何事）
     void setText(const QString &text);
 
 private:
-    QGraphicsTextItem *tooltipText;  // 用于显示文本的图形文本项
+    QGraphicsTextItem *tooltipText;  // 当前显示的文本项
+    // 已排版的文本：卡片的提示只在冷却、阳光状态间切换，每种文本只排版一次
+    QHash<QString, QGraphicsTextItem *> layouts;
 };
 
 // 植物卡片项类，继承自可处理鼠标事件的像素图项
@@ -53,4 +55,66 @@ private:
     QPixmap uncheckedImage;  // 未选中状态图像
 };
 
+/**
+ * @brief 游戏中的卡片栏
+ *
+ * 在一个图元中绘制全部已选卡片：冷却遮罩按源矩形直接从卡片图像中绘制，不生成新的位图，
+ * 只有卡片状态或遮罩高度（像素）变化时才重绘对应的卡片。悬停与点击按卡片序号发出信号
+ */
+class SeedBankItem: public QObject, public QGraphicsItem
+{
+    Q_OBJECT
+    Q_INTERFACES(QGraphicsItem)
+
+public:
+    explicit SeedBankItem(const QList<Plant *> &plants);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+    // 卡片数量
+    int count() const;
+    // 场景坐标处的卡片序号，不在卡片上时为 -1
+    int cardAt(const QPointF &scenePos) const;
+    // 卡片左上角的场景坐标
+    QPointF cardScenePos(int index) const;
+
+    // 设置卡片的选中（可用）状态
+    void setChecked(int index, bool checked);
+    bool isChecked(int index) const;
+    // 设置卡片的冷却进度(0.0~1.0)
+    void setPercent(int index, double value);
+
+    static const int CardSpacing = 60;  // 卡片的纵向间距
+
+signals:
+    void hoverEntered(int index, QGraphicsSceneHoverEvent *event);
+    void hoverMoved(int index, QGraphicsSceneHoverEvent *event);
+    void hoverLeft(int index, QGraphicsSceneHoverEvent *event);
+
+protected:
+    void hoverEnterEvent(QGraphicsSceneHoverEvent *event) override;
+    void hoverMoveEvent(QGraphicsSceneHoverEvent *event) override;
+    void hoverLeaveEvent(QGraphicsSceneHoverEvent *event) override;
+
+private:
+    struct Card {
+        QPixmap checkedImage;    // 可用状态图像
+        QPixmap uncheckedImage;  // 不可用状态图像（已加暗）
+        int lowestHeight, highestHeight;    // 遮罩高度的范围
+        QStaticText sunNum;      // 阳光花费
+        QPointF sunNumPos;
+        bool checked;
+        int maskHeight;          // 冷却遮罩的高度（像素）
+    };
+
+    QRectF cardRect(int index) const;
+    void setHovered(int index, QGraphicsSceneHoverEvent *event);
+
+    QVector<Card> cards;
+    QFont sunNumFont;
+    QSizeF cardSize;
+    int hovered;    // 鼠标所在的卡片，没有时为 -1
+};
+
 #endif //PLANTS_VS_ZOMBIES_PLANTCARD_H
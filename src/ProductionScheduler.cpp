@@ -0,0 +1,79 @@
+// 资源生产调度器的实现文件：生产者登记、到期事件的排序与发出
+
+#include "ProductionScheduler.h"
+
+ProductionScheduler::ProductionScheduler(QObject *parent)
+        : QObject(parent), tick(0), sequence(0), nextId(1)
+{}
+
+int ProductionScheduler::addProducer(const Producer &producer, int delay)
+{
+    int id = nextId++;
+    producers.insert(id, { producer, 0, false, Key() });
+    scheduleProduction(id, tick + qMax(1, delay));
+    return id;
+}
+
+void ProductionScheduler::removeProducer(int id)
+{
+    auto iter = producers.find(id);
+    if (iter == producers.end())
+        return;
+    queue.erase(iter->key);
+    producers.erase(iter);
+}
+
+void ProductionScheduler::setAmount(int id, int amount)
+{
+    auto iter = producers.find(id);
+    if (iter != producers.end())
+        iter->producer.amount = amount;
+}
+
+qint64 ProductionScheduler::currentTick() const
+{
+    return tick;
+}
+
+// 有提前量时先排 charging 事件，否则直接排生产事件
+void ProductionScheduler::scheduleProduction(int id, qint64 productionTick)
+{
+    Entry &entry = producers[id];
+    entry.productionTick = productionTick;
+    if (entry.producer.lead > 0)
+        enqueue(id, qMax(tick + 1, productionTick - entry.producer.lead), true);
+    else
+        enqueue(id, productionTick, false);
+}
+
+void ProductionScheduler::enqueue(int id, qint64 time, bool charging)
+{
+    Entry &entry = producers[id];
+    entry.charging = charging;
+    entry.key = qMakePair(time, sequence++);
+    queue.emplace(entry.key, id);
+}
+
+// 信号的接收者可能登记或移除生产者，因此每次都先把事件移出队列，发出信号后重新查找生产者
+void ProductionScheduler::advance()
+{
+    ++tick;
+    while (!queue.empty() && queue.begin()->first.first <= tick) {
+        int id = queue.begin()->second;
+        queue.erase(queue.begin());
+        Entry entry = producers.value(id);
+
+        if (entry.charging) {
+            enqueue(id, entry.productionTick, false);
+            emit charging(id, entry.producer.source);
+            continue;
+        }
+
+        const Producer &producer = entry.producer;
+        int interval = producer.minInterval;
+        if (producer.maxInterval > producer.minInterval)
+            interval += qrand() % (producer.maxInterval - producer.minInterval + 1);
+        scheduleProduction(id, tick + qMax(1, interval));
+        emit produced(id, producer.source, producer.amount);
+    }
+}
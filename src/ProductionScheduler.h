@@ -0,0 +1,65 @@
+#ifndef PLANTS_VS_ZOMBIES_PRODUCTIONSCHEDULER_H
+#define PLANTS_VS_ZOMBIES_PRODUCTIONSCHEDULER_H
+
+#include <QtCore>
+#include <map>
+
+class PlantInstance;
+
+/**
+ * @brief 资源生产调度器
+ *
+ * 所有生产者（天空掉落的阳光、向日葵等）的下一次生产时刻保存在同一个按时间排序的队列中，
+ * 由场景每轮监控调用 advance 推进（每轮 100ms），到点时发出 produced 信号，阳光的显示逻辑订阅该信号。
+ * 设置了提前量 lead 的生产者会在生产前 lead 轮先发出 charging 信号（如向日葵开始发光）。
+ * 新的生产者（双子向日葵、阳光菇等）只需登记不同的产量与间隔
+ */
+class ProductionScheduler: public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Producer {
+        PlantInstance *source;          // 产出所在的植物，天空掉落的阳光为空
+        int amount;                     // 每次的产量
+        int minInterval, maxInterval;   // 两次生产之间的轮数，在 [min, max] 中随机
+        int lead;                       // 生产前提前发出 charging 的轮数，0 为不发出
+    };
+
+    explicit ProductionScheduler(QObject *parent = nullptr);
+
+    // 登记生产者，delay 轮后第一次生产，返回生产者编号
+    int addProducer(const Producer &producer, int delay);
+    void removeProducer(int id);
+    // 修改之后每次的产量（如阳光菇长大）
+    void setAmount(int id, int amount);
+
+    // 推进一轮，依次发出到期的事件
+    void advance();
+    qint64 currentTick() const;
+
+signals:
+    void charging(int id, PlantInstance *source);
+    void produced(int id, PlantInstance *source, int amount);
+
+private:
+    typedef QPair<qint64, quint64> Key;   // (到期轮数, 登记序号)，同一轮的事件按登记顺序发出
+
+    struct Entry {
+        Producer producer;
+        qint64 productionTick;          // 下一次生产的轮数
+        bool charging;                  // 队列中的事件是否为 charging
+        Key key;                        // 在队列中的位置
+    };
+
+    void scheduleProduction(int id, qint64 productionTick);
+    void enqueue(int id, qint64 tick, bool charging);
+
+    QHash<int, Entry> producers;
+    std::map<Key, int> queue;           // 到期时间 -> 生产者编号
+    qint64 tick;
+    quint64 sequence;
+    int nextId;
+};
+
+#endif //PLANTS_VS_ZOMBIES_PRODUCTIONSCHEDULER_H
@@ -7,6 +7,8 @@
 #include "GameLevelData.h"
 #include "GameScene.h"
 #include "ZombieInfoScene.h"
+#include "AudioManager.h"
+#include "TraceRecorder.h"
 
 // 无边界文本项类的绘制函数，去除选中和焦点状态的边框
 TextItemWithoutBorder::TextItemWithoutBorder(const QString &text, QGraphicsItem *parent)
@@ -33,10 +35,10 @@ SelectorScene::SelectorScene()
           woodSign1       (new QGraphicsPixmapItem    (gImageCache->load("interface/SelectorWoodSign1.png"))),
           woodSign2       (new QGraphicsPixmapItem    (gImageCache->load("interface/SelectorWoodSign2.png"))),
           woodSign3       (new QGraphicsPixmapItem    (gImageCache->load("interface/SelectorWoodSign3.png"))),
-          zombieHand      (new MoviePixmapItem        ("interface/SelectorZombieHand.gif")),
+          zombieHand      (new MoviePixmapItem),  // 点击冒险模式之前看不到，动画在第一次播放时才解码
           quitButton      (new MouseEventRectItem     (QRectF(0, 0, 79, 53))),
           usernameText    (new TextItemWithoutBorder  (gMainView->getUsername())),
-          backgroundMusic(new QMediaPlayer(this))
+          backgroundMusic(nullptr)
 {
     // 添加背景到场景
     addItem(background);
@@ -76,17 +78,10 @@ SelectorScene::SelectorScene()
     usernameText->installEventFilter(this);
     usernameText->setTextInteractionFlags(Qt::TextEditorInteraction);
 
-    // 设置背景音乐并连接循环播放信号
-    backgroundMusic->setMedia(QUrl("qrc:/audio/Faster.mp3"));
-    connect(backgroundMusic, &QMediaPlayer::stateChanged, [this](QMediaPlayer::State state) {
-        if (state == QMediaPlayer::StoppedState)
-            backgroundMusic->play();
-    });
-
     // 连接按钮的悬停信号到播放音效
-    connect(adventureButton, &HoverChangedPixmapItem::hoverEntered, [] { QSound::play(":/audio/bleep.wav"); });
-    connect(bookButton, &HoverChangedPixmapItem::hoverEntered, [] { QSound::play(":/audio/bleep.wav"); });
-    //connect(challengeButton, &HoverChangedPixmapItem::hoverEntered, [] { QSound::play(":/audio/bleep.wav"); });
+    connect(adventureButton, &HoverChangedPixmapItem::hoverEntered, [] { AudioManager::play(":/audio/bleep.wav"); });
+    connect(bookButton, &HoverChangedPixmapItem::hoverEntered, [] { AudioManager::play(":/audio/bleep.wav"); });
+    //connect(challengeButton, &HoverChangedPixmapItem::hoverEntered, [] { AudioManager::play(":/audio/bleep.wav"); });
 
     // 连接冒险按钮的点击信号到僵尸手动画和场景切换
     connect(adventureButton, &HoverChangedPixmapItem::clicked, zombieHand, [this] {
@@ -99,28 +94,35 @@ SelectorScene::SelectorScene()
         //challengeButton->setEnabled(false);
         woodSign3->setEnabled(false);
 
+        zombieHand->setMovie("interface/SelectorZombieHand.gif");
         zombieHand->start();
-        backgroundMusic->blockSignals(true);
-        backgroundMusic->stop();
-        backgroundMusic->blockSignals(false);
-        backgroundMusic->setMedia(QUrl("qrc:/audio/losemusic.mp3"));
-        backgroundMusic->play();
+        if (backgroundMusic) {
+            backgroundMusic->blockSignals(true);
+            backgroundMusic->stop();
+            backgroundMusic->blockSignals(false);
+            backgroundMusic->setMedia(QUrl("qrc:/audio/losemusic.mp3"));
+            backgroundMusic->play();
+        }
     });
 
     // 连接书本按钮的点击信号到僵尸信息场景切换
     connect(bookButton, &HoverChangedPixmapItem::clicked, [this] {
-           backgroundMusic->blockSignals(true);
-           backgroundMusic->stop();
-           backgroundMusic->blockSignals(false);
+           if (backgroundMusic) {
+               backgroundMusic->blockSignals(true);
+               backgroundMusic->stop();
+               backgroundMusic->blockSignals(false);
+           }
            gMainView->switchToScene(new ZombieInfoScene);
        });
 
     // 连接僵尸手动画的结束信号到游戏场景切换
     connect(zombieHand, &MoviePixmapItem::finished, [this] {
         (new Timer(this, 2500, [this](){
-            backgroundMusic->blockSignals(true);
-            backgroundMusic->stop();
-            backgroundMusic->blockSignals(false);
+            if (backgroundMusic) {
+                backgroundMusic->blockSignals(true);
+                backgroundMusic->stop();
+                backgroundMusic->blockSignals(false);
+            }
             gMainView->switchToScene(new GameScene(GameLevelDataFactory(QSettings().value("Global/NextLevel", "1").toString())));
         }))->start();
     });
@@ -161,5 +163,28 @@ void SelectorScene::loadReady()
     //moveItemWithDuration(woodSign2, QPointF(23, 126), 500, [] {}, QTimeLine::EaseOutCurve);
     //moveItemWithDuration(woodSign3, QPointF(34, 179), 600, [] {}, QTimeLine::EaseOutCurve);
     gMainView->getMainWindow()->setWindowTitle(tr("Plants vs. Zombies"));
+    // 创建播放器需要加载多媒体插件，关卡界面的图片此时也看不到，都放到首帧显示之后
+    QPointer<SelectorScene> self(this);
+    gMainView->runAfterNextFrame([self] {
+        if (self)
+            self->loadDeferred();
+    });
+}
+
+// 首帧之后的加载：开始背景音乐，并在后台解码进入关卡时要用的界面图片
+void SelectorScene::loadDeferred()
+{
+    TRACE_SCOPE("startup", "SelectorScene::loadDeferred");
+    // 设置背景音乐并连接循环播放信号
+    backgroundMusic = new QMediaPlayer(this);
+    backgroundMusic->setMedia(QUrl("qrc:/audio/Faster.mp3"));
+    connect(backgroundMusic, &QMediaPlayer::stateChanged, [this](QMediaPlayer::State state) {
+        if (state == QMediaPlayer::StoppedState)
+            backgroundMusic->play();
+    });
     backgroundMusic->play();
+
+    gImageCache->prefetch({ "interface/background1.jpg", "interface/Button.png", "interface/SunBack.png",
+                            "interface/SelectCardButton.png", "interface/SeedChooser_Background.png",
+                            "interface/Shovel.png", "interface/ShovelBack.png" });
 }
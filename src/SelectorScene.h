@@ -26,6 +26,8 @@ public:
 
     void loadReady();
 private:
+    void loadDeferred();
+
     QGraphicsPixmapItem *background;
     QGraphicsPixmapItem *adventureShadow;
     HoverChangedPixmapItem *adventureButton;
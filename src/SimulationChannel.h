@@ -0,0 +1,59 @@
+#ifndef PLANTS_VS_ZOMBIES_SIMULATIONCHANNEL_H
+#define PLANTS_VS_ZOMBIES_SIMULATIONCHANNEL_H
+
+#include <QtCore>
+
+/**
+ * @brief 三缓冲：模拟端写入并发布快照，绘制端取得最新发布的快照
+ *
+ * 写端与读端各自独占一个缓冲，中间缓冲的下标与“有新快照”标志打包在一个原子整数中，
+ * 发布与取得各只是一次原子交换，双方互不等待。写端拿到的缓冲是更早的快照，写入前需要覆盖全部内容。
+ * 两次交换都需要获取-释放语义（QAtomicInt 没有单独的 AcqRel，用 Ordered）：
+ * 发布时释放写入的内容、取得交回的缓冲；读端交回旧缓冲时释放对它的读取，写端才能安全地重新写入
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer(): middle(1), writeIndex(0), readIndex(2) {}
+
+    // 写端：正在写入的缓冲
+    T &back() { return buffers[writeIndex]; }
+    // 写端：发布 back() 的内容，换回中间缓冲继续写入
+    void publish()
+    {
+        writeIndex = middle.fetchAndStoreOrdered(writeIndex | Fresh) & IndexMask;
+    }
+
+    // 读端：有新发布的快照时换到 front()，返回是否换过
+    bool update()
+    {
+        if (!(middle.loadAcquire() & Fresh))
+            return false;
+        readIndex = middle.fetchAndStoreOrdered(readIndex) & IndexMask;
+        return true;
+    }
+    // 读端：最近取得的快照
+    const T &front() const { return buffers[readIndex]; }
+
+private:
+    enum { IndexMask = 3, Fresh = 4 };
+
+    T buffers[3];
+    QAtomicInt middle;          // 中间缓冲的下标 | Fresh
+    int writeIndex, readIndex;
+};
+
+// 一轮模拟结束时发布给绘制端的不可变快照，只含值，不引用模拟端的对象
+struct RenderSnapshot {
+    struct ZombieState {
+        QUuid uuid;                 // 僵尸，绘制端据此找到图元
+        qreal x;                    // 图片横坐标
+        int hp;                     // 生命值，耗尽后不再由快照设置图元
+    };
+
+    qint64 tick;                    // 模拟轮数
+    QVector<ZombieState> zombies;
+};
+
+#endif //PLANTS_VS_ZOMBIES_SIMULATIONCHANNEL_H
@@ -0,0 +1,83 @@
+// 启动阶段计时的实现文件
+
+#include "StartupReport.h"
+#include "TraceRecorder.h"
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+StartupReport *gStartupReport = nullptr;
+
+// 进程从创建到此刻经过的纳秒数（Linux 下由 /proc 读取，其他平台返回 -1）
+static qint64 processAge()
+{
+#ifdef Q_OS_LINUX
+    QFile stat("/proc/self/stat"), uptime("/proc/uptime");
+    if (!stat.open(QIODevice::ReadOnly) || !uptime.open(QIODevice::ReadOnly))
+        return -1;
+    // 进程名可能含空格，从最后一个右括号之后开始计数；starttime 是第22个字段
+    QByteArray line = stat.readAll();
+    QList<QByteArray> fields = line.mid(line.lastIndexOf(')') + 2).split(' ');
+    if (fields.size() < 20)
+        return -1;
+    double startTime = fields[19].toDouble() / sysconf(_SC_CLK_TCK);
+    double now = uptime.readAll().split(' ').value(0).toDouble();
+    return now > startTime ? qint64((now - startTime) * 1e9) : -1;
+#else
+    return -1;
+#endif
+}
+
+StartupReport::StartupReport(const QElapsedTimer &clock)
+        : clock(clock), firstFramePainted(false)
+{
+    qint64 age = processAge();
+    beforeMain = age >= 0 ? qMax(Q_INT64_C(0), age - clock.nsecsElapsed()) : -1;
+}
+
+void StartupReport::mark(const char *phase)
+{
+    phases.push_back(qMakePair(phase, clock.nsecsElapsed()));
+    TRACE_INSTANT("startup", phase);
+}
+
+void StartupReport::frameFinished()
+{
+    if (firstFramePainted)
+        return;
+    firstFramePainted = true;
+    mark("first frame");
+}
+
+bool StartupReport::isFirstFramePainted() const
+{
+    return firstFramePainted;
+}
+
+void StartupReport::write() const
+{
+    QTextStream out(stderr);
+    out << "startup report (ms)\n";
+    if (beforeMain >= 0)
+        out << QString("  %1 %2\n").arg("process start -> main", -28).arg(beforeMain / 1e6, 9, 'f', 2);
+    qint64 last = 0;
+    for (const auto &phase: phases) {
+        out << QString("  %1 %2  (at %3)\n").arg(phase.first, -28)
+                .arg((phase.second - last) / 1e6, 9, 'f', 2).arg(phase.second / 1e6, 0, 'f', 2);
+        last = phase.second;
+    }
+    out << QString("  %1 %2\n").arg("total since main", -28).arg(last / 1e6, 9, 'f', 2);
+}
+
+void InitStartupReport(const QElapsedTimer &clock)
+{
+    if (!gStartupReport)
+        gStartupReport = new StartupReport(clock);
+}
+
+void DestroyStartupReport()
+{
+    delete gStartupReport;
+    gStartupReport = nullptr;
+}
@@ -0,0 +1,43 @@
+#ifndef PLANTS_VS_ZOMBIES_STARTUPREPORT_H
+#define PLANTS_VS_ZOMBIES_STARTUPREPORT_H
+
+#include <QtCore>
+
+/**
+ * @brief 启动阶段计时
+ *
+ * 只在命令行指定 --startup-report 时存在（gStartupReport 非空）。
+ * 各阶段结束时通过 STARTUP_PHASE 记下时间，首帧绘制完成、延后的加载也执行完之后输出到标准错误
+ */
+class StartupReport
+{
+public:
+    // clock 为 main 开始时启动的计时器，之前的阶段（进程创建到进入 main）另行从系统读取
+    explicit StartupReport(const QElapsedTimer &clock);
+
+    // 记录一个阶段在此刻结束
+    void mark(const char *phase);
+    // 首帧绘制完成（只记录第一次）
+    void frameFinished();
+    bool isFirstFramePainted() const;
+
+    // 输出各阶段耗时
+    void write() const;
+
+private:
+    QElapsedTimer clock;
+    qint64 beforeMain;                           // 进程创建到进入 main 的纳秒数，未知时为 -1
+    QVector<QPair<const char *, qint64> > phases; // 阶段名与结束时刻（纳秒）
+    bool firstFramePainted;
+};
+
+extern StartupReport *gStartupReport;
+
+void InitStartupReport(const QElapsedTimer &clock);
+void DestroyStartupReport();
+
+// 记录一个启动阶段；未开启报告时只做一次指针判断
+#define STARTUP_PHASE(phase) \
+    do { if (gStartupReport) gStartupReport->mark(phase); } while (0)
+
+#endif //PLANTS_VS_ZOMBIES_STARTUPREPORT_H
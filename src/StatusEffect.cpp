@@ -0,0 +1,75 @@
+// 状态效果组件的实现文件：施加、移除、逐轮推进与序列化
+
+#include "StatusEffect.h"
+
+StatusEffects::StatusEffects()
+{
+    for (Effect &effect: effects)
+        effect = { 0, 0, 0, 0 };
+}
+
+bool StatusEffects::isEmpty() const
+{
+    for (const Effect &effect: effects)
+        if (effect.remaining)
+            return false;
+    return true;
+}
+
+bool StatusEffects::has(Type type) const
+{
+    return effects[type].remaining != 0;
+}
+
+int StatusEffects::remaining(Type type) const
+{
+    return effects[type].remaining;
+}
+
+void StatusEffects::apply(Type type, int ticks, int damage, int period)
+{
+    Effect &effect = effects[type];
+    if (!effect.remaining)
+        effect = { ticks, damage, period, 0 };
+    else if (effect.remaining != Permanent && (ticks == Permanent || ticks > effect.remaining))
+        effect.remaining = ticks;
+}
+
+void StatusEffects::remove(Type type)
+{
+    effects[type] = { 0, 0, 0, 0 };
+}
+
+int StatusEffects::tick(int *expired)
+{
+    int damage = 0;
+    *expired = 0;
+    for (int type = 0; type < TypeCount; ++type) {
+        Effect &effect = effects[type];
+        if (!effect.remaining)
+            continue;
+        if (effect.damage && effect.period > 0 && ++effect.elapsed >= effect.period) {
+            effect.elapsed = 0;
+            damage += effect.damage;
+        }
+        if (effect.remaining != Permanent && --effect.remaining == 0) {
+            effect = { 0, 0, 0, 0 };
+            *expired |= 1 << type;
+        }
+    }
+    return damage;
+}
+
+QDataStream &operator<<(QDataStream &out, const StatusEffects &effects)
+{
+    for (const StatusEffects::Effect &effect: effects.effects)
+        out << effect.remaining << effect.damage << effect.period << effect.elapsed;
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, StatusEffects &effects)
+{
+    for (StatusEffects::Effect &effect: effects.effects)
+        in >> effect.remaining >> effect.damage >> effect.period >> effect.elapsed;
+    return in;
+}
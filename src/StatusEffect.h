@@ -0,0 +1,48 @@
+#ifndef PLANTS_VS_ZOMBIES_STATUSEFFECT_H
+#define PLANTS_VS_ZOMBIES_STATUSEFFECT_H
+
+#include <QtCore>
+
+/**
+ * @brief 僵尸身上的状态效果组件
+ *
+ * 持续时间以监控轮数计（每轮 100ms），由场景在每轮监控中对所有带效果的僵尸统一推进
+ * （见 GameScene::updateStatusEffects），不为单个效果创建计时器。
+ * 同类效果不叠加：再次施加时剩余时间取两者中较长的一个。
+ * 数据只有几个整数，可以用 QDataStream 直接保存与恢复
+ */
+class StatusEffects
+{
+public:
+    enum Type {
+        Slow,       // 减速（寒冰豌豆），火球会将其抵消
+        Decay,      // 持续掉血（失去头部后）
+        TypeCount
+    };
+    enum { Permanent = -1 };    // 不会自行结束的持续时间
+
+    StatusEffects();
+
+    bool isEmpty() const;
+    bool has(Type type) const;
+    int remaining(Type type) const;     // 剩余轮数，Permanent 表示不会结束
+
+    // 施加效果：ticks 为持续轮数；damage/period 表示每 period 轮造成 damage 点伤害（0 为无伤害）
+    void apply(Type type, int ticks, int damage = 0, int period = 0);
+    void remove(Type type);
+
+    // 推进一轮，返回本轮造成的伤害；本轮到期的效果以 (1 << type) 置位在 expired 中
+    int tick(int *expired);
+
+    friend QDataStream &operator<<(QDataStream &out, const StatusEffects &effects);
+    friend QDataStream &operator>>(QDataStream &in, StatusEffects &effects);
+
+private:
+    struct Effect {
+        qint32 remaining;   // 剩余轮数，0 为未生效
+        qint32 damage, period, elapsed;
+    };
+    Effect effects[TypeCount];
+};
+
+#endif //PLANTS_VS_ZOMBIES_STATUSEFFECT_H
@@ -0,0 +1,281 @@
+// 压力测试场景的实现文件：布置植物与僵尸潮，并周期性输出性能数据
+
+#include "StressScenario.h"
+#include "GameScene.h"
+#include "MainView.h"
+#include "MouseEventPixmapItem.h"
+#include "Zombie.h"
+
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#elif defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+StressScenario::StressScenario(QObject *parent)
+        : QObject(parent),
+          fillPlant("oPeashooter"), fillCols(9),
+          zombieName("oZombie"), zombiesPerRow(500), spacing(4),
+          reportInterval(1000), duration(0),
+          reportTimer(new QTimer(this))
+{
+    connect(reportTimer, &QTimer::timeout, [this] { report(); });
+}
+
+StressScenario *StressScenario::fromSpec(const QString &spec, QString *error)
+{
+    StressScenario *scenario = new StressScenario;
+    auto fail = [scenario, error](const QString &message) -> StressScenario * {
+        if (error)
+            *error = message;
+        delete scenario;
+        return nullptr;
+    };
+
+    for (const QString &item: spec.split(',', QString::SkipEmptyParts)) {
+        int eq = item.indexOf('=');
+        if (eq <= 0)
+            return fail(QString("Invalid stress option \"%1\"").arg(item));
+        QString key = item.left(eq).trimmed(), value = item.mid(eq + 1).trimmed();
+        bool ok = true;
+        if (key == "plants")
+            scenario->fillPlant = value;
+        else if (key == "cols")
+            scenario->fillCols = value.toInt(&ok);
+        else if (key == "zombies")
+            scenario->zombieName = value;
+        else if (key == "count")
+            scenario->zombiesPerRow = value.toInt(&ok);
+        else if (key == "spacing")
+            scenario->spacing = value.toDouble(&ok);
+        else if (key == "report")
+            scenario->reportInterval = value.toInt(&ok);
+        else if (key == "duration")
+            scenario->duration = value.toInt(&ok);
+        else if (key == "csv")
+            scenario->csvFileName = value;
+        else if (key == "layout") {
+            // 逐格布局：名称@列:行，以分号分隔
+            // 列 0 为割草机所在列，行列范围取压力测试关卡的默认坐标系（coord 为 0）
+            QRegularExpression re("^(\\w+)@(\\d+):(\\d+)$");
+            Coordinate coordinate(0);
+            for (const QString &cell: value.split(';', QString::SkipEmptyParts)) {
+                QRegularExpressionMatch match = re.match(cell.trimmed());
+                if (!match.hasMatch())
+                    return fail(QString("Invalid stress layout cell \"%1\"").arg(cell));
+                int col = match.captured(2).toInt(), row = match.captured(3).toInt();
+                if (col > coordinate.colCount() || row < 1 || row > coordinate.rowCount())
+                    return fail(QString("Stress layout cell \"%1\" is outside the lawn (columns 0-%2, rows 1-%3)")
+                                        .arg(cell).arg(coordinate.colCount()).arg(coordinate.rowCount()));
+                scenario->layout.push_back({ match.captured(1), col, row });
+            }
+        }
+        else
+            return fail(QString("Unknown stress option \"%1\"").arg(key));
+        if (!ok)
+            return fail(QString("Invalid value for stress option \"%1\"").arg(key));
+    }
+    return scenario;
+}
+
+void StressScenario::setPlantLayout(const QList<StressPlacement> &layout)
+{
+    this->layout = layout;
+}
+
+void StressScenario::fillLawn(const QString &plantName, int cols)
+{
+    layout.clear();
+    fillPlant = plantName;
+    fillCols = cols;
+}
+
+void StressScenario::setHorde(const QString &zombieName, int zombiesPerRow, qreal spacing)
+{
+    this->zombieName = zombieName;
+    this->zombiesPerRow = zombiesPerRow;
+    this->spacing = spacing;
+}
+
+void StressScenario::setReportInterval(int ms)
+{
+    reportInterval = ms;
+}
+
+void StressScenario::setDuration(int ms)
+{
+    duration = ms;
+}
+
+void StressScenario::setCsvFile(const QString &fileName)
+{
+    csvFileName = fileName;
+}
+
+GameLevelData *StressScenario::createLevel()
+{
+    return new GameLevelData_Stress(this);
+}
+
+QString StressScenario::start(GameScene *scene)
+{
+    Coordinate &coordinate = scene->getCoordinate();
+
+    // 布置植物：未指定逐格布局时把前 fillCols 列全部种满
+    QList<StressPlacement> placements = layout;
+    if (placements.isEmpty() && !fillPlant.isEmpty()) {
+        for (int row = 1; row <= coordinate.rowCount(); ++row)
+            for (int col = 1; col <= qMin(fillCols, coordinate.colCount()); ++col)
+                placements.push_back({ fillPlant, col, row });
+    }
+
+    // 名称由工厂识别，在布置任何东西之前全部检查
+    for (const auto &placement: placements)
+        if (!scene->getPlantProtoType(placement.eName))
+            return QString("Unknown stress plant \"%1\"").arg(placement.eName);
+    Zombie *zombie = scene->getZombieProtoType(zombieName);
+    if (!zombie)
+        return QString("Unknown stress zombie \"%1\"").arg(zombieName);
+
+    this->scene = scene;
+    for (const auto &placement: placements)
+        scene->customSpecial(placement.eName, placement.col, placement.row);
+
+    // 生成僵尸潮：同一行的僵尸依次向右错开 spacing，使其陆续进入草坪
+    for (int row = 1; row <= coordinate.rowCount(); ++row) {
+        if (!zombie->canPass(row))
+            continue;
+        for (int i = 0; i < zombiesPerRow; ++i) {
+            ZombieInstance *zombieInstance = scene->spawnZombie(zombie, row);
+            qreal offset = i * spacing;
+            zombieInstance->X += offset;
+            zombieInstance->ZX = zombieInstance->attackedLX += offset;
+            zombieInstance->attackedRX += offset;
+            zombieInstance->picture->setX(zombieInstance->X);
+        }
+    }
+
+    scene->setTickObserver([this](qint64 nsecs) { ticks.add(nsecs); });
+    gMainView->setFrameObserver([this](qint64 nsecs) { frames.add(nsecs); });
+
+    qInfo().noquote() << QString("[stress] %1 plants, %2 x %3 zombies per row")
+            .arg(placements.size()).arg(zombieName).arg(zombiesPerRow);
+    if (!csvFileName.isEmpty()) {
+        QFile csv(csvFileName);
+        if (csv.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            csv.write("time_ms,zombies,ticks,tick_avg_ms,tick_max_ms,frames,frame_avg_ms,frame_max_ms,qobjects,qtimers,rss_bytes\n");
+    }
+
+    clock.start();
+    reportTimer->start(reportInterval);
+    if (duration > 0) {
+        QTimer::singleShot(duration, this, [this] {
+            report();
+            qInfo().noquote() << "[stress] finished";
+            qApp->quit();
+        });
+    }
+    return QString();
+}
+
+void StressScenario::report()
+{
+    if (!scene) {
+        reportTimer->stop();
+        return;
+    }
+
+    int zombies = 0;
+    for (int row = 1; row <= scene->getCoordinate().rowCount(); ++row)
+        zombies += scene->getZombieOnRow(row).size();
+    int objects, timers;
+    countLiveObjects(&objects, &timers);
+    qint64 rss = residentMemory();
+
+    auto avgMs = [](const Sample &sample) { return sample.count ? sample.total / 1e6 / sample.count : 0.0; };
+    qInfo().noquote() << QString("[stress] t=%1s zombies=%2 tick avg=%3ms max=%4ms (%5) "
+                                 "frame avg=%6ms max=%7ms (%8) QObjects=%9 QTimers=%10 RSS=%11MB")
+            .arg(clock.elapsed() / 1000.0, 0, 'f', 1).arg(zombies)
+            .arg(avgMs(ticks), 0, 'f', 2).arg(ticks.max / 1e6, 0, 'f', 2).arg(ticks.count)
+            .arg(avgMs(frames), 0, 'f', 2).arg(frames.max / 1e6, 0, 'f', 2).arg(frames.count)
+            .arg(objects).arg(timers)
+            .arg(rss >= 0 ? QString::number(rss / 1048576.0, 'f', 1) : QString("n/a"));
+
+    if (!csvFileName.isEmpty()) {
+        QFile csv(csvFileName);
+        if (csv.open(QIODevice::WriteOnly | QIODevice::Append))
+            csv.write(QString("%1,%2,%3,%4,%5,%6,%7,%8,%9,%10,%11\n")
+                              .arg(clock.elapsed()).arg(zombies)
+                              .arg(ticks.count).arg(avgMs(ticks)).arg(ticks.max / 1e6)
+                              .arg(frames.count).arg(avgMs(frames)).arg(frames.max / 1e6)
+                              .arg(objects).arg(timers).arg(rss).toUtf8());
+    }
+
+    ticks = Sample();
+    frames = Sample();
+}
+
+// 统计场景中存活的 QObject 与 QTimer：场景的子对象 + 兼具 QObject 身份的图形项及其子对象
+void StressScenario::countLiveObjects(int *objects, int *timers) const
+{
+    *objects = 1 + scene->findChildren<QObject *>().size();
+    *timers = scene->findChildren<QTimer *>().size();
+    for (QGraphicsItem *item: scene->items()) {
+        if (QObject *object = dynamic_cast<QObject *>(item)) {
+            *objects += 1 + object->findChildren<QObject *>().size();
+            *timers += object->findChildren<QTimer *>().size();
+        }
+    }
+}
+
+// 当前进程的常驻内存（字节），不支持的平台返回-1
+qint64 StressScenario::residentMemory()
+{
+#if defined(Q_OS_LINUX)
+    QFile statm("/proc/self/statm");
+    if (statm.open(QIODevice::ReadOnly)) {
+        QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.size() > 1)
+            return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+    }
+    return -1;
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.WorkingSetSize;
+    return -1;
+#else
+    return -1;
+#endif
+}
+
+// 压力测试关卡：沿用第一关的植物与背景，关闭选卡和滚屏
+GameLevelData_Stress::GameLevelData_Stress(StressScenario *scenario)
+        : scenario(scenario)
+{
+    backgroundImage = "interface/background1.jpg";
+    backgroundMusic = "qrc:/audio/UraniwaNi.mp3";
+    sunNum = 9990;
+    canSelectCard = false;
+    showScroll = false;
+    produceSun = false;
+    eName = "stress";
+    cName = tr("Stress Test");
+    pName = { "oPeashooter", "oSnowPea", "oSunflower", "oWallNut", "oTorchwood", "oRepeater" };
+    zName = { "oZombie" };
+}
+
+void GameLevelData_Stress::startGame(GameScene *gameScene)
+{
+    gameScene->beginBGM();
+    gameScene->beginMonitor();
+    gameScene->beginCool();
+    if (scenario) {
+        QString error = scenario->start(gameScene);
+        if (!error.isEmpty()) {
+            qCritical().noquote() << error;
+            qApp->exit(1);
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef PLANTS_VS_ZOMBIES_STRESSSCENARIO_H
+#define PLANTS_VS_ZOMBIES_STRESSSCENARIO_H
+
+#include <QtCore>
+#include "GameLevelData.h"
+
+class GameScene;
+class StressScenario;
+
+/**
+ * @brief 压力测试场景的一个植物摆放位置
+ */
+struct StressPlacement
+{
+    QString eName;  // 植物英文名称
+    int col, row;   // 所在列与行
+};
+
+/**
+ * @brief 压力测试场景
+ *
+ * 通过 customSpecial 按任意布局铺满草坪，再通过 ZombieInstanceFactory 的正常流程
+ * 在每一行生成成百上千的僵尸，并周期性输出监控耗时、帧耗时、存活的 QObject/QTimer 数量和内存占用，
+ * 作为可复现的最坏情况供性能优化对比
+ */
+class StressScenario: public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit StressScenario(QObject *parent = nullptr);
+
+    /**
+     * @brief 解析命令行传入的场景描述
+     * @param spec 形如 "plants=oPeashooter,cols=5,zombies=oZombie,count=500,report=1000" 的描述
+     * @param error 解析失败时写入错误信息
+     * @return 解析失败返回nullptr
+     *
+     * 支持的键：plants（铺满草坪的植物）、cols（铺满的列数）、
+     * layout（逐格布局，如 oWallNut@9:1;oPeashooter@1:3，指定后忽略 plants）、
+     * zombies（僵尸名称）、count（每行僵尸数）、spacing（同一行僵尸之间的间距）、
+     * report（报告间隔毫秒）、duration（运行时长毫秒，0表示不自动退出）、csv（报告同时追加写入的文件）
+     */
+    static StressScenario *fromSpec(const QString &spec, QString *error = nullptr);
+
+    // 场景配置
+    void setPlantLayout(const QList<StressPlacement> &layout);
+    void fillLawn(const QString &plantName, int cols);
+    void setHorde(const QString &zombieName, int zombiesPerRow, qreal spacing);
+    void setReportInterval(int ms);
+    void setDuration(int ms);
+    void setCsvFile(const QString &fileName);
+
+    // 创建使用本场景的关卡数据（交给 GameScene 接管）
+    GameLevelData *createLevel();
+
+    // 由关卡的 startGame 调用：摆放植物、生成僵尸并开始统计，植物或僵尸名称无效时不做任何布置并返回错误信息
+    QString start(GameScene *scene);
+
+private:
+    void report();
+    void countLiveObjects(int *objects, int *timers) const;
+    static qint64 residentMemory();
+
+    // 配置
+    QList<StressPlacement> layout;
+    QString fillPlant;
+    int fillCols;
+    QString zombieName;
+    int zombiesPerRow;
+    qreal spacing;
+    int reportInterval, duration;
+    QString csvFileName;
+
+    // 运行状态
+    QPointer<GameScene> scene;
+    QElapsedTimer clock;
+    QTimer *reportTimer;
+
+    // 当前报告区间内的统计数据（纳秒）
+    struct Sample {
+        int count = 0;
+        qint64 total = 0, max = 0;
+        void add(qint64 ns) { ++count; total += ns; max = qMax(max, ns); }
+    };
+    Sample ticks, frames;
+};
+
+/**
+ * @brief 压力测试关卡
+ * 不选卡、不滚屏、没有割草机，开始后把场景交给 StressScenario 布置
+ */
+class GameLevelData_Stress : public GameLevelData
+{
+    Q_DECLARE_TR_FUNCTIONS(GameLevelData_Stress)
+public:
+    explicit GameLevelData_Stress(StressScenario *scenario);
+
+    virtual void startGame(GameScene *gameScene) override;
+
+private:
+    QPointer<StressScenario> scenario;
+};
+
+#endif //PLANTS_VS_ZOMBIES_STRESSSCENARIO_H
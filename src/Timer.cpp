@@ -1,27 +1,91 @@
 // 定时器类的实现文件，包括普通定时器和时间线定时器的实现
 
 #include "Timer.h"
+#include "PerfMonitor.h"
+#include "ObjectCounter.h"
+#include "GameClock.h"
 
 // 普通定时器构造函数，初始化定时器的间隔、类型和超时处理函数
-Timer::Timer(QObject *parent, int timeout, std::function<void(void)> functor) : QTimer(parent)
+Timer::Timer(QObject *parent, int timeout, std::function<void(void)> functor, const char *file, int line)
+        : QTimer(parent), functor(functor), file(file), line(line), generation(0)
 {
+    OBJECT_COUNTER_INC("Timer");
     setInterval(timeout);
     if (timeout < 50)
         setTimerType(Qt::PreciseTimer);
     setSingleShot(true);
-    connect(this, &Timer::timeout, [this, functor] { functor(); deleteLater(); });
+    connect(this, &Timer::timeout, [this] { fire(); });
+}
+
+Timer::~Timer()
+{
+    OBJECT_COUNTER_DEC("Timer");
+}
+
+void Timer::start()
+{
+    if (!gGameClock) {
+        QTimer::start();
+        return;
+    }
+    // 重新 start 或 stop 之后，之前预约的事件到时不再执行
+    quint64 scheduled = ++generation;
+    gGameClock->schedule(interval(), this, [this, scheduled] {
+        if (scheduled == generation) {
+            ++generation;
+            fire();
+        }
+    });
+}
+
+void Timer::stop()
+{
+    ++generation;
+    QTimer::stop();
+}
+
+// 执行回调后释放自身；回调中可能连同父对象一起删除了本计时器，此时不能再调用 deleteLater
+void Timer::fire()
+{
+    QPointer<Timer> self(this);
+    {
+        TraceScope scope("timer", "Timer", file, line);
+        functor();
+    }
+    if (self)
+        deleteLater();
 }
 
 // 时间线定时器构造函数，初始化时间线的持续时间、更新间隔、值变化处理函数和结束处理函数
 TimeLine::TimeLine(QObject *parent, int duration, int interval, std::function<void(qreal)> onChanged, std::function<void(void)> onFinished, CurveShape shape)
-        : QTimeLine(duration, parent)
+        : QTimeLine(duration, parent), onFinished(onFinished)
 {
-    if (duration == 0) {
-        int i = 1;
-        ++i;
-    }
+    OBJECT_COUNTER_INC("TimeLine");
     setUpdateInterval(40);
     setCurveShape(shape);
-    connect(this, &TimeLine::valueChanged, onChanged);
-    connect(this, &TimeLine::finished, [this, onFinished] { onFinished(); deleteLater(); });
+    connect(this, &TimeLine::valueChanged, [onChanged](qreal x) {
+        PerfScope scope(PerfMonitor::Animations);
+        TRACE_SCOPE("animation", "TimeLine");
+        onChanged(x);
+    });
+    connect(this, &TimeLine::finished, [this] { this->onFinished(); deleteLater(); });
+}
+
+TimeLine::~TimeLine()
+{
+    OBJECT_COUNTER_DEC("TimeLine");
+}
+
+// 虚拟时钟下不逐帧更新，到时直接跳到终点并结束
+void TimeLine::start()
+{
+    if (!gGameClock) {
+        QTimeLine::start();
+        return;
+    }
+    gGameClock->schedule(duration(), this, [this] {
+        setCurrentTime(duration());
+        onFinished();
+        deleteLater();
+    });
 }
@@ -7,18 +7,40 @@
 
 
 #include <QtCore>
+#include "TraceRecorder.h"
 
 // Just for convenience
+// file/line 默认取调用者的位置，用于追踪记录中标注计时器的创建点
+// 开启虚拟时钟（gGameClock）时，start/stop 改由 GameClock 计时，因此须通过 Timer/TimeLine 指针调用
 class Timer: public QTimer
 {
 public:
-    Timer(QObject *parent, int timeout, std::function<void(void)> functor);
+    Timer(QObject *parent, int timeout, std::function<void(void)> functor,
+          const char *file = PVZ_CALLER_FILE, int line = PVZ_CALLER_LINE);
+    ~Timer();
+
+    void start();
+    void stop();
+
+private:
+    void fire();
+
+    std::function<void(void)> functor;
+    const char *file;
+    int line;
+    quint64 generation;   // 每次 start/stop 递增，虚拟时钟下只执行最近一次 start 预约的事件
 };
 
 class TimeLine: public QTimeLine
 {
 public:
     TimeLine(QObject *parent, int duration, int interval, std::function<void(qreal)> onChanged, std::function<void(void)> onFinished = [] {}, CurveShape shape = EaseInOutCurve);
+    ~TimeLine();
+
+    void start();
+
+private:
+    std::function<void(void)> onFinished;
 };
 
 #endif //PLANTS_VS_ZOMBIES_TIMEER_H
@@ -0,0 +1,106 @@
+// 追踪事件记录器的实现文件：环形缓冲区与 Chrome trace event JSON 导出
+
+#include "TraceRecorder.h"
+
+TraceRecorder *gTraceRecorder = nullptr;
+
+TraceRecorder::TraceRecorder(int capacity)
+        : events(qMax(1, capacity)), next(0), size(0)
+{
+    clock.start();
+}
+
+void TraceRecorder::complete(const char *category, const char *name, qint64 begin, qint64 duration,
+                             const char *file, int line, const QString &detail)
+{
+    int thread = currentThreadIndex();
+    QMutexLocker locker(&mutex);
+    events[next] = { category, name, begin, duration, file, line, thread, detail };
+    next = (next + 1) % events.size();
+    size = qMin(size + 1, events.size());
+}
+
+void TraceRecorder::instant(const char *category, const char *name, const QString &detail)
+{
+    complete(category, name, now(), -1, nullptr, 0, detail);
+}
+
+qint64 TraceRecorder::now() const
+{
+    return clock.nsecsElapsed();
+}
+
+// 为每个线程分配一个从1开始的编号，作为 trace 中的 tid
+int TraceRecorder::currentThreadIndex()
+{
+    static QAtomicInt counter(0);
+    static thread_local int index = 0;
+    if (!index)
+        index = ++counter;
+    return index;
+}
+
+// 转义 JSON 字符串中的特殊字符
+static QString jsonEscape(const QString &text)
+{
+    QString result;
+    result.reserve(text.size());
+    for (QChar c: text) {
+        if (c == '"' || c == '\\')
+            result += '\\';
+        if (c.unicode() < 0x20)
+            result += QString("\\u%1").arg(c.unicode(), 4, 16, QChar('0'));
+        else
+            result += c;
+    }
+    return result;
+}
+
+bool TraceRecorder::writeJson(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+
+    QMutexLocker locker(&mutex);
+    QTextStream out(&file);
+    out.setCodec("UTF-8");
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Plants vs Zombies\"}}";
+
+    // 环形缓冲区写满后，最旧的事件位于 next 处
+    int first = size < events.size() ? 0 : next;
+    for (int i = 0; i < size; ++i) {
+        const Event &event = events[(first + i) % events.size()];
+        out << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+            << "\",\"pid\":1,\"tid\":" << event.thread
+            << ",\"ts\":" << QString::number(event.begin / 1000.0, 'f', 3);
+        if (event.duration >= 0)
+            out << ",\"ph\":\"X\",\"dur\":" << QString::number(event.duration / 1000.0, 'f', 3);
+        else
+            out << ",\"ph\":\"i\",\"s\":\"t\"";
+
+        QStringList args;
+        if (event.file && *event.file)
+            args << QString("\"site\":\"%1:%2\"").arg(jsonEscape(QFileInfo(event.file).fileName())).arg(event.line);
+        if (!event.detail.isEmpty())
+            args << QString("\"detail\":\"%1\"").arg(jsonEscape(event.detail));
+        if (!args.isEmpty())
+            out << ",\"args\":{" << args.join(',') << "}";
+        out << "}";
+    }
+    out << "\n]}\n";
+    return out.status() == QTextStream::Ok;
+}
+
+void InitTraceRecorder(int capacity)
+{
+    if (!gTraceRecorder)
+        gTraceRecorder = new TraceRecorder(capacity);
+}
+
+void DestroyTraceRecorder()
+{
+    delete gTraceRecorder;
+    gTraceRecorder = nullptr;
+}
@@ -0,0 +1,106 @@
+#ifndef PLANTS_VS_ZOMBIES_TRACERECORDER_H
+#define PLANTS_VS_ZOMBIES_TRACERECORDER_H
+
+#include <QtCore>
+
+// 取得调用点的文件与行号（用作默认参数时记录的是调用者的位置）
+#if defined(__GNUC__) || defined(__clang__)
+#define PVZ_CALLER_FILE __builtin_FILE()
+#define PVZ_CALLER_LINE __builtin_LINE()
+#else
+#define PVZ_CALLER_FILE ""
+#define PVZ_CALLER_LINE 0
+#endif
+
+/**
+ * @brief 追踪事件记录器
+ *
+ * 把带时间戳的事件写入定长环形缓冲区（写满后覆盖最旧的事件），
+ * 退出时导出为 Chrome/Perfetto 可读取的 trace event JSON。
+ * 只在命令行指定 --trace 时存在（gTraceRecorder 非空），否则各处的 TRACE_* 宏只做一次指针判断
+ */
+class TraceRecorder
+{
+public:
+    explicit TraceRecorder(int capacity);
+
+    // 记录一个完整事件（ph = "X"），时间单位为纳秒
+    void complete(const char *category, const char *name, qint64 begin, qint64 duration,
+                  const char *file = nullptr, int line = 0, const QString &detail = QString());
+    // 记录一个瞬时事件（ph = "i"）
+    void instant(const char *category, const char *name, const QString &detail = QString());
+
+    // 自记录器创建以来的纳秒数
+    qint64 now() const;
+
+    // 按时间顺序导出缓冲区中的事件
+    bool writeJson(const QString &fileName) const;
+
+private:
+    struct Event {
+        const char *category, *name;
+        qint64 begin, duration;     // duration < 0 表示瞬时事件
+        const char *file;
+        int line;
+        int thread;
+        QString detail;
+    };
+
+    static int currentThreadIndex();
+
+    QElapsedTimer clock;
+    QVector<Event> events;
+    int next, size;
+    mutable QMutex mutex;
+};
+
+extern TraceRecorder *gTraceRecorder;
+
+void InitTraceRecorder(int capacity);
+void DestroyTraceRecorder();
+
+/**
+ * @brief 追踪作用域：构造时记下开始时间，析构时写入一个完整事件
+ */
+class TraceScope
+{
+public:
+    TraceScope(const char *category, const char *name, const char *file = nullptr, int line = 0)
+            : category(category), name(name), file(file), line(line),
+              begin(gTraceRecorder ? gTraceRecorder->now() : -1)
+    {}
+
+    TraceScope(const char *category, const char *name, const QString &detail)
+            : TraceScope(category, name)
+    {
+        if (begin >= 0)
+            this->detail = detail;
+    }
+
+    ~TraceScope()
+    {
+        if (begin >= 0 && gTraceRecorder)
+            gTraceRecorder->complete(category, name, begin, gTraceRecorder->now() - begin, file, line, detail);
+    }
+
+private:
+    const char *category, *name, *file;
+    int line;
+    qint64 begin;
+    QString detail;
+};
+
+#define PVZ_TRACE_CONCAT_(a, b) a##b
+#define PVZ_TRACE_CONCAT(a, b) PVZ_TRACE_CONCAT_(a, b)
+
+// 记录当前作用域的耗时；category 与 name 必须是字符串字面量
+#define TRACE_SCOPE(category, name) \
+    TraceScope PVZ_TRACE_CONCAT(traceScope, __LINE__)(category, name)
+// 同上，附带一段说明（如文件名），说明只在记录开启时才被复制
+#define TRACE_SCOPE_DETAIL(category, name, detail) \
+    TraceScope PVZ_TRACE_CONCAT(traceScope, __LINE__)(category, name, detail)
+// 记录一个瞬时事件
+#define TRACE_INSTANT(category, name) \
+    do { if (gTraceRecorder) gTraceRecorder->instant(category, name); } while (0)
+
+#endif //PLANTS_VS_ZOMBIES_TRACERECORDER_H
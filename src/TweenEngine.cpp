@@ -0,0 +1,189 @@
+// 补间引擎的实现文件：连续存放的补间与每帧统一推进
+
+#include "TweenEngine.h"
+#include "PerfMonitor.h"
+#include "TraceRecorder.h"
+#include "ObjectCounter.h"
+#include "GameClock.h"
+
+// 各场景的补间引擎（引擎析构时移除）
+static QHash<QGraphicsScene *, TweenEngine *> engines;
+
+// 与 QTimeLine 相同的曲线形状到缓动曲线的对应
+static QEasingCurve curveFor(QTimeLine::CurveShape shape)
+{
+    switch (shape) {
+        case QTimeLine::EaseInCurve:
+            return QEasingCurve(QEasingCurve::InCurve);
+        case QTimeLine::EaseOutCurve:
+            return QEasingCurve(QEasingCurve::OutCurve);
+        case QTimeLine::LinearCurve:
+            return QEasingCurve(QEasingCurve::Linear);
+        case QTimeLine::SineCurve:
+            return QEasingCurve(QEasingCurve::SineCurve);
+        case QTimeLine::CosineCurve:
+            return QEasingCurve(QEasingCurve::CosineCurve);
+        default:
+            return QEasingCurve(QEasingCurve::InOutSine);
+    }
+}
+
+TweenEngine::TweenEngine(QGraphicsScene *scene)
+        : QObject(scene), scene(scene), serial(0)
+{
+    OBJECT_COUNTER_INC("TweenEngine");
+    clock.start();
+    driver.setInterval(16);  // 每帧推进一次
+    driver.setTimerType(Qt::PreciseTimer);
+    connect(&driver, &QTimer::timeout, [this] { advance(); });
+}
+
+TweenEngine::~TweenEngine()
+{
+    // 场景销毁时图形项随之销毁，未完成的关键帧不再回调
+    engines.remove(scene);
+    OBJECT_COUNTER_DEC("TweenEngine");
+}
+
+TweenEngine *TweenEngine::of(QGraphicsScene *scene)
+{
+    TweenEngine *&engine = engines[scene];
+    if (!engine)
+        engine = new TweenEngine(scene);
+    return engine;
+}
+
+qint64 TweenEngine::now() const
+{
+    return gGameClock ? gGameClock->now() : clock.elapsed();
+}
+
+void TweenEngine::append(QGraphicsItem *item, const KeyFrame &keyFrame)
+{
+    auto iter = index.find(item);
+    if (iter != index.end()) {
+        tweens[*iter].frames.push_back(keyFrame);
+        return;
+    }
+    index.insert(item, tweens.size());
+    tweens.push_back({ item, { keyFrame }, 0, 0, QPointF(), 0, 0, QEasingCurve() });
+    startNext(item);
+}
+
+QList<TweenEngine::KeyFrame> TweenEngine::cancel(QGraphicsItem *item)
+{
+    auto iter = index.find(item);
+    if (iter == index.end())
+        return QList<KeyFrame>();
+    QList<KeyFrame> frames = tweens[*iter].frames;
+    removeAt(*iter);
+    return frames;
+}
+
+bool TweenEngine::contains(QGraphicsItem *item) const
+{
+    return index.contains(item);
+}
+
+int TweenEngine::count() const
+{
+    return tweens.size();
+}
+
+// 回调中可能增删任意补间（数组会移动），因此每次回调后都重新按图形项查找
+void TweenEngine::startNext(QGraphicsItem *item)
+{
+    forever {
+        auto iter = index.find(item);
+        if (iter == index.end())
+            return;
+        Tween &tween = tweens[*iter];
+        if (tween.frames.isEmpty()) {
+            removeAt(*iter);
+            return;
+        }
+
+        KeyFrame &keyFrame = tween.frames.first();
+        tween.fromPos = item->pos();
+        tween.fromScale = item->scale();
+        tween.fromOpacity = item->opacity();
+        if (!keyFrame.duration) {
+            QPointF posVec = keyFrame.toPos - tween.fromPos;
+            keyFrame.duration = qRound(qSqrt(QPointF::dotProduct(posVec, posVec)) / keyFrame.speed);
+        }
+        if (keyFrame.duration > 0) {
+            tween.serial = ++serial;
+            tween.start = now();
+            tween.curve = curveFor(keyFrame.shape);
+            if (gGameClock)
+                gGameClock->schedule(keyFrame.duration, this, [this] { advance(); });
+            else if (!driver.isActive())
+                driver.start();
+            return;
+        }
+
+        std::function<void(bool)> finished = keyFrame.finished;
+        quint64 current = tween.serial;
+        tween.frames.pop_front();
+        finished(true);
+        if (!isCurrent(item, current))
+            return;  // 回调中已重新开始
+    }
+}
+
+// 图形项的补间是否仍停留在序号为 frameSerial 的关键帧上（没有被取消或重新开始）
+bool TweenEngine::isCurrent(QGraphicsItem *item, quint64 frameSerial) const
+{
+    auto iter = index.find(item);
+    return iter != index.end() && tweens[*iter].serial == frameSerial;
+}
+
+void TweenEngine::advance()
+{
+    PerfScope scope(PerfMonitor::Animations);
+    TRACE_SCOPE("animation", "TweenEngine::advance");
+
+    // 先设置所有补间的当前值，再依次完成到期的关键帧
+    qint64 time = now();
+    QVector<QPair<QGraphicsItem *, quint64> > expired;
+    for (Tween &tween: tweens) {
+        if (tween.frames.isEmpty())
+            continue;
+        const KeyFrame &keyFrame = tween.frames.first();
+        qreal progress = qMin(qreal(1), qreal(time - tween.start) / keyFrame.duration);
+        qreal x = tween.curve.valueForProgress(progress);
+        if (keyFrame.type & MOVE)
+            tween.item->setPos((keyFrame.toPos - tween.fromPos) * x + tween.fromPos);
+        if (keyFrame.type & SCALE)
+            tween.item->setScale((keyFrame.toScale - tween.fromScale) * x + tween.fromScale);
+        if (keyFrame.type & FADE)
+            tween.item->setOpacity((keyFrame.toOpacity - tween.fromOpacity) * x + tween.fromOpacity);
+        if (progress >= 1)
+            expired.push_back(qMakePair(tween.item, tween.serial));
+    }
+
+    for (const auto &pair: expired) {
+        // 先完成的关键帧的回调可能已经取消或替换了这个补间
+        if (!isCurrent(pair.first, pair.second))
+            continue;
+        Tween &tween = tweens[index.value(pair.first)];
+        std::function<void(bool)> finished = tween.frames.first().finished;
+        tween.frames.pop_front();
+        finished(true);
+        if (isCurrent(pair.first, pair.second))
+            startNext(pair.first);
+    }
+
+    if (tweens.isEmpty())
+        driver.stop();
+}
+
+void TweenEngine::removeAt(int i)
+{
+    index.remove(tweens[i].item);
+    if (i != tweens.size() - 1) {
+        tweens[i] = tweens.last();
+        index[tweens[i].item] = i;
+    }
+    tweens.pop_back();
+}
@@ -0,0 +1,76 @@
+#ifndef PLANTS_VS_ZOMBIES_TWEENENGINE_H
+#define PLANTS_VS_ZOMBIES_TWEENENGINE_H
+
+#include <QtWidgets>
+#include <functional>
+
+/**
+ * @brief 补间引擎
+ *
+ * 每个场景一个，随场景销毁。场景中所有进行中的补间（每个图形项一个，带有待执行的关键帧序列）
+ * 连续存放在同一个数组中，由一个计时器每帧统一按曲线计算并设置位置、缩放与透明度，
+ * 同时下落的五十个阳光只需要一个计时器。虚拟时钟下不逐帧更新，在最早结束的关键帧到期时统一推进
+ */
+class TweenEngine: public QObject
+{
+public:
+    // 关键帧类型（位掩码）
+    enum KeyFrameType {
+        MOVE = 0x01,    // 移动
+        SCALE = 0x02,   // 缩放
+        FADE = 0x04     // 透明度
+    };
+
+    // 关键帧：起点为开始执行时图形项的当前状态
+    struct KeyFrame {
+        int type;               // KeyFrameType 的组合
+        int duration;           // 持续时间（毫秒），为0时由移动距离与 speed 计算
+        qreal speed;            // 移动速度（像素/毫秒）
+        QPointF toPos;          // 目标位置
+        qreal toScale;          // 目标缩放比例
+        qreal toOpacity;        // 目标透明度
+        std::function<void(bool)> finished; // 完成回调，被取消时参数为 false
+        QTimeLine::CurveShape shape; // 曲线形状
+    };
+
+    // 取得场景的补间引擎（首次使用时创建）
+    static TweenEngine *of(QGraphicsScene *scene);
+
+    // 在图形项的关键帧序列末尾追加一帧，图形项没有进行中的补间时立即开始
+    void append(QGraphicsItem *item, const KeyFrame &keyFrame);
+    // 移除图形项的补间，返回尚未完成的关键帧（不调用其回调）
+    QList<KeyFrame> cancel(QGraphicsItem *item);
+    // 图形项是否有进行中的补间
+    bool contains(QGraphicsItem *item) const;
+    // 进行中的补间数
+    int count() const;
+
+private:
+    explicit TweenEngine(QGraphicsScene *scene);
+    ~TweenEngine() override;
+
+    struct Tween {
+        QGraphicsItem *item;
+        QList<KeyFrame> frames;         // 首个为当前关键帧
+        quint64 serial;                 // 当前关键帧的开始序号，用于识别推进期间被替换的补间
+        qint64 start;                   // 当前关键帧的开始时间
+        QPointF fromPos;
+        qreal fromScale, fromOpacity;
+        QEasingCurve curve;
+    };
+
+    qint64 now() const;
+    void startNext(QGraphicsItem *item);    // 开始图形项的首个关键帧，时长为0的关键帧立即完成
+    void advance();                         // 推进所有补间并完成到期的关键帧
+    bool isCurrent(QGraphicsItem *item, quint64 frameSerial) const;
+    void removeAt(int i);
+
+    QGraphicsScene *scene;
+    QVector<Tween> tweens;
+    QHash<QGraphicsItem *, int> index;      // 图形项 -> 在 tweens 中的下标
+    quint64 serial;
+    QTimer driver;
+    QElapsedTimer clock;
+};
+
+#endif //PLANTS_VS_ZOMBIES_TWEENENGINE_H
@@ -5,6 +5,8 @@
 #include "MouseEventPixmapItem.h"
 #include "Plant.h"
 #include "Timer.h"
+#include "AudioManager.h"
+#include "ObjectCounter.h"
 
 
 //Zombie 类是所有僵尸类的基类，它定义了僵尸的基本属性和方法，例如僵尸的名称、生命值、速度、攻击方式等
@@ -15,7 +17,14 @@ Zombie::Zombie()
       canSelect(true), canDisplay(true), // 可选中/可显示标识
       beAttackedPointL(82), beAttackedPointR(156), // 攻击判定左右边界
       breakPoint(90), sunNum(0), coolTime(0) // 护甲破碎阈值/产生阳光数/冷却时间
-{}
+{
+    OBJECT_COUNTER_INC("Zombie");
+}
+
+Zombie::~Zombie()
+{
+    OBJECT_COUNTER_DEC("Zombie");
+}
 
 // 判断僵尸是否可通过指定行（陆地/水面判定）
 bool Zombie::canPass(int row) const
@@ -27,9 +36,9 @@ bool Zombie::canPass(int row) const
 // 更新僵尸图片尺寸（根据静态图自动获取）
 void Zombie::update()
 {
-    QPixmap pic = gImageCache->load(staticGif); // 加载静态图片
-    width = pic.width();  // 更新宽度
-    height = pic.height();// 更新高度
+    QSize size = gImageCache->imageSize(staticGif); // 只读取静态图片的尺寸，不解码
+    width = size.width();  // 更新宽度
+    height = size.height();// 更新高度
 }
 
 // Zombie1类构造函数（普通僵尸）
@@ -83,7 +92,7 @@ FlagZombie::FlagZombie()
     cardGif = "Card/Zombies/FlagZombie.png"; // 卡片图片
     staticGif = path + "0.gif";       // 静态站立
     normalGif = path + "FlagZombie.gif";  // 行走动画（附带音效）
-    QSound::play(":/audio/splat1.wav");     // 出场音效
+    AudioManager::play(":/audio/splat1.wav");     // 出场音效
     attackGif = path + "FlagZombieAttack.gif"; // 攻击
     lostHeadGif = path + "FlagZombieLostHead.gif"; // 失头行走
     lostHeadAttackGif = path + "FlagZombieLostHeadAttack.gif"; // 失头攻击
@@ -92,16 +101,26 @@ FlagZombie::FlagZombie()
 
 // ZombieInstance构造函数（僵尸实例）
 ZombieInstance::ZombieInstance(const Zombie *zombie)
-    : zombieProtoType(zombie), frozenTimer(nullptr), picture(new MoviePixmapItem)
+    : zombieProtoType(zombie), picture(zombie->scene->takePicture())
 {
+    OBJECT_COUNTER_INC("ZombieInstance");
     uuid = QUuid::createUuid(); // 生成唯一标识
     hp = zombieProtoType->hp;  // 继承原型生命值
+    pendingDamage = 0;         // 待结算伤害
+    eatState = EatIdle;        // 啃食状态机
+    eatTicks = 0;
+    hitFlash = 0;              // 受击闪烁
+    statusEffectListed = false;
     orignSpeed = speed = zombie->speed; // 原始速度/当前速度
     orignAttack = attack = zombie->attack; // 原始攻击/当前攻击
     altitude = 1;            // 高度（1=地面）
     beAttacked = true;       // 可被攻击标识
     isAttacking = false;     // 攻击状态
     goingDie = false;        // 死亡状态
+    dead = false;
+    instanceIndex = -1;
+    triggerFreeFrom = triggerFreeTo = 0;  // 空区间，首次检测时计算
+    triggerEpoch = 0;
     normalGif = zombie->normalGif; // 行走动画
     attackGif = zombie->attackGif; // 攻击动画
     lostHeadGif = zombie->lostHeadGif; // 失头动画
@@ -168,6 +187,8 @@ void ZombieInstance::checkActs() //判定输赢
 {
     if (hp < 1) return;                                              // 生命值为0时不执行任何操作
 
+    updateCooldowns();                                               // 推进啃食等冷却状态
+
     // 检查是否可攻击且未在攻击状态
     if (beAttacked && !isAttacking) {
         judgeAttack();                                               // 判断是否攻击植物
@@ -177,8 +198,7 @@ void ZombieInstance::checkActs() //判定输赢
     if (!isAttacking) {
         attackedRX -= speed;                                          // 右边界左移（向左移动）
         ZX = attackedLX -= speed;                                     // 更新攻击判定左边界和ZX坐标
-        X -= speed;                                                  // 僵尸图片位置左移
-        picture->setX(X);                                             // 更新渲染位置
+        X -= speed;                                                  // 僵尸图片位置左移（由绘制端按快照设置图元）
 
         // 超出屏幕范围时销毁僵尸
         if (attackedRX < -50) {
@@ -200,17 +220,11 @@ void ZombieInstance::judgeAttack()
     // 获取当前ZX坐标对应的列号
     int col = zombieProtoType->scene->getCoordinate().getCol(ZX);
     if (col >= 1 && col <= 9) {                                       // 检查列号有效性
-        auto plants = zombieProtoType->scene->getPlant(col, row);      // 获取该位置所有植物
-        QList<int> keys = plants.keys();                              // 获取植物类型键列表
-
-        // 按类型降序排序（优先检查高优先级植物）
-        qSort(keys.begin(), keys.end(), [](int a, int b) { return b < a; });
-
-        // 遍历植物列表寻找可攻击目标
-        for (auto key: keys) {
-            plant = plants[key];
-            // 检查植物是否可被吃且僵尸在攻击范围内
-            if (plant->plantProtoType->canEat && plant->attackedRX >= ZX && plant->attackedLX <= ZX) {
+        // 该格可被啃食的植物已按类型降序缓存（优先检查高优先级植物）
+        for (PlantInstance *target: zombieProtoType->scene->getEatTargets(col, row)) {
+            // 检查僵尸是否在攻击范围内
+            if (target->attackedRX >= ZX && target->attackedLX <= ZX) {
+                plant = target;
                 tempIsAttacking = true;
                 break;
             }
@@ -233,41 +247,47 @@ void ZombieInstance::judgeAttack()
         normalAttack(plant);
 }
 
-// 普通攻击函数（对植物造成伤害）
-void ZombieInstance::normalAttack(PlantInstance *plantInstance)
+// 随机播放两种啃食音效
+static void playChompAudio()
 {
-    // 随机播放两种啃食音效
     if (qrand() % 2)
-        QSound::play(":/audio/chomp.wav");
+        AudioManager::play(":/audio/chomp.wav");
     else
-        QSound::play(":/audio/chompsoft.wav");
-
-    // 0.5秒后再次播放音效（模拟持续啃食）
-    (new Timer(this->picture, 500, [this] {
-        if (qrand() % 2)
-            QSound::play(":/audio/chomp.wav");
-        else
-            QSound::play(":/audio/chompsoft.wav");
-    }))->start();
+        AudioManager::play(":/audio/chompsoft.wav");
+}
 
-    // 记录目标植物UUID
-    QUuid plantUuid = plantInstance->uuid;
+// 普通攻击函数（开始啃食植物，伤害在 BiteInterval 轮后造成）
+void ZombieInstance::normalAttack(PlantInstance *plantInstance)
+{
+    playChompAudio();
+    eatState = EatChewing;
+    eatTicks = BiteInterval;
+    eatTarget = plantInstance->uuid;
+}
 
-    // 1秒后执行伤害逻辑
-    (new Timer(this->picture, 1000, [this, plantUuid] {
-        if (beAttacked) {                                            // 僵尸可被攻击时才执行
-            PlantInstance *plant = zombieProtoType->scene->getPlant(plantUuid);
-            if (plant)
-                plant->getHurt(this, zombieProtoType->aKind, attack);  // 对植物造成伤害
-            judgeAttack();                                           // 重新判断攻击状态
-        }
-    }))->start();
+void ZombieInstance::updateCooldowns()
+{
+    if (eatState != EatChewing)
+        return;
+    // 半口时再次播放音效（模拟持续啃食）
+    if (--eatTicks == BiteInterval / 2)
+        playChompAudio();
+    if (eatTicks > 0)
+        return;
+    eatState = EatIdle;
+    if (beAttacked) {                                                // 僵尸可被攻击时才执行
+        PlantInstance *plant = zombieProtoType->scene->getPlant(eatTarget);
+        if (plant)
+            plant->getHurt(this, zombieProtoType->aKind, attack);     // 对植物造成伤害
+        judgeAttack();                                               // 重新判断攻击状态（仍有目标时开始下一口）
+    }
 }
 
 // 析构函数（释放资源）
 ZombieInstance::~ZombieInstance()
 {
-    picture->deleteLater();                                          // 延迟删除图片项，避免渲染冲突
+    OBJECT_COUNTER_DEC("ZombieInstance");
+    zombieProtoType->scene->releasePicture(picture);                 // 图片放回对象池
 }
 
 
@@ -318,14 +338,22 @@ void ZombieInstance::getPea(int attack, int direction)
     getHit(attack);
 }
 
-// 僵尸受到伤害的核心处理函数
+// 僵尸受到伤害：先累计到本轮，由场景在下一轮监控开始时统一结算
 void ZombieInstance::getHit(int attack)
+{
+    if (!pendingDamage)
+        zombieProtoType->scene->queueDamage(this);
+    pendingDamage += attack;
+}
+
+// 结算伤害的核心处理函数
+void ZombieInstance::takeDamage(int damage)
 {
     // 若不可被攻击或已死亡则跳过
     if (!beAttacked || goingDie)
         return;
     // 减少生命值
-    hp -= attack;
+    hp -= damage;
     // 生命值低于护甲破碎阈值时触发头部脱落
     if (hp < zombieProtoType->breakPoint) {
         // 更新动画为失头状态（根据是否在攻击选择不同动画）
@@ -349,26 +377,58 @@ void ZombieInstance::getHit(int attack)
         autoReduceHp();
     }
     // 未触发护甲破碎时显示受击闪烁效果
-    else {
+    else
+        startHitFlash();
+}
+
+int ZombieInstance::hpAfterPendingDamage() const
+{
+    if (!beAttacked || goingDie)
+        return hp;
+    return hp - pendingDamage;
+}
+
+// 半透明 100ms；倒计时由场景在每帧绘制前推进，连续受击只会重置倒计时
+void ZombieInstance::startHitFlash()
+{
+    if (!hitFlash) {
         picture->setOpacity(0.5);
-        (new Timer(picture, 100, [this] {
-            picture->setOpacity(1);
-        }))->start();
+        zombieProtoType->scene->addHitFlash(this);
     }
+    hitFlash = 100;
 }
 
-// 僵尸失头后持续掉血的处理函数
+// 僵尸失头后持续掉血的处理函数：每秒（10轮监控）减少60点生命值，直到死亡
 void ZombieInstance::autoReduceHp()
 {
-    // 每秒减少60点生命值
-    (new Timer(picture, 1000, [this] {
-        hp-= 60;
-        // 生命值归0时执行正常死亡逻辑
+    applyStatusEffect(StatusEffects::Decay, StatusEffects::Permanent, 60, 10);
+}
+
+// 施加状态效果，首次带有效果时登记到场景的统一更新中
+void ZombieInstance::applyStatusEffect(StatusEffects::Type type, int ticks, int damage, int period)
+{
+    if (statusEffects.isEmpty())
+        zombieProtoType->scene->addStatusEffectZombie(this);
+    statusEffects.apply(type, ticks, damage, period);
+}
+
+void ZombieInstance::updateStatusEffects()
+{
+    int expired;
+    int damage = statusEffects.tick(&expired);
+    // 持续掉血，生命值归0时执行正常死亡逻辑
+    if (damage && !goingDie) {
+        hp -= damage;
         if (hp < 1)
             normalDie();
-        else
-            autoReduceHp();  // 继续掉血
-    }))->start();
+    }
+    if (goingDie)
+        statusEffects.remove(StatusEffects::Decay);
+    // 减速结束，恢复正常状态
+    if (expired & (1 << StatusEffects::Slow)) {
+        speed = orignSpeed;
+        attack = orignAttack;
+    }
 }
 
 // 僵尸正常死亡的处理函数
@@ -392,9 +452,9 @@ void ZombieInstance::normalDie()
 void ZombieInstance::playNormalballAudio()
 {
     switch (qrand() % 3) {
-        case 0: QSound::play(":/audio/splat1.wav"); break;
-        case 1: QSound::play(":/audio/splat2.wav"); break;
-        default: QSound::play(":/audio/splat3.wav"); break;
+        case 0: AudioManager::play(":/audio/splat1.wav"); break;
+        case 1: AudioManager::play(":/audio/splat2.wav"); break;
+        default: AudioManager::play(":/audio/splat3.wav"); break;
     }
 }
 
@@ -421,20 +481,10 @@ bool ZombieInstance::getCrushed(PlantInstance *instance)
 // 僵尸被冰冻豌豆击中的处理函数
 void ZombieInstance::getSnowPea(int attack, int direction)
 {
-    // 清除已有的冰冻效果
-    if (frozenTimer) {
-        frozenTimer->stop();
-        frozenTimer->deleteLater();
-    }
-    // 降低移动速度和攻击力（持续10秒）
+    // 降低移动速度和攻击力，持续10秒（100轮监控），再次击中时重新计时
     speed = orignSpeed / 2;
     this->attack = 50;
-    // 10秒后恢复正常状态
-    (frozenTimer = new Timer(picture, 10000, [this] {
-        frozenTimer = nullptr;
-        speed = orignSpeed;
-        this->attack = orignAttack;
-    }))->start();
+    applyStatusEffect(StatusEffects::Slow, 100);
     // 播放冰冻音效
     playSlowballAudio();
     // 执行伤害计算
@@ -444,17 +494,15 @@ void ZombieInstance::getSnowPea(int attack, int direction)
 // 播放冰冻音效的函数
 void ZombieInstance::playSlowballAudio()
 {
-    QSound::play(":/audio/frozen.wav");
+    AudioManager::play(":/audio/frozen.wav");
 }
 
 // 僵尸被火球击中的处理函数（移除冰冻效果并造成伤害）
 void ZombieInstance::getFirePea(int attack, int direction)
 {
     // 若有冰冻效果则清除
-    if (frozenTimer) {
-        frozenTimer->stop();
-        frozenTimer->deleteLater();
-        frozenTimer = nullptr;
+    if (statusEffects.has(StatusEffects::Slow)) {
+        statusEffects.remove(StatusEffects::Slow);
         speed = orignSpeed;
         this->attack = orignAttack;
     }
@@ -468,9 +516,9 @@ void ZombieInstance::getFirePea(int attack, int direction)
 void ZombieInstance::playFireballAudio()
 {
     if (qrand() % 2)
-        QSound::play(":/audio/ignite.wav");
+        AudioManager::play(":/audio/ignite.wav");
     else
-        QSound::play(":/audio/ignite2.wav");
+        AudioManager::play(":/audio/ignite2.wav");
 }
 
 
@@ -488,11 +536,11 @@ const OrnZombie1 *OrnZombieInstance1::getZombieProtoType()
     return static_cast<const OrnZombie1 *>(zombieProtoType);
 }
 
-// 重写受击函数，处理护甲逻辑
-void OrnZombieInstance1::getHit(int attack)
+// 重写伤害结算函数，处理护甲逻辑
+void OrnZombieInstance1::takeDamage(int damage)
 {
     if (hasOrnaments) {                     // 护甲存在时
-        ornHp -= attack;                    // 先扣除护甲生命值
+        ornHp -= damage;                    // 先扣除护甲生命值
         if (ornHp < 1) {                    // 护甲被击破
             hp += ornHp;                    // 将剩余护甲值加到本体生命值（可能为负值）
             hasOrnaments = false;           // 标记护甲已丢失
@@ -503,13 +551,17 @@ void OrnZombieInstance1::getHit(int attack)
             picture->start();
         }
         // 受击闪烁效果
-        picture->setOpacity(0.5);
-        (new Timer(picture, 100, [this] {
-            picture->setOpacity(1);
-        }))->start();
+        startHitFlash();
     }
     else
-        ZombieInstance::getHit(attack);     // 无护甲时调用基类受击逻辑
+        ZombieInstance::takeDamage(damage); // 无护甲时调用基类受击逻辑
+}
+
+int OrnZombieInstance1::hpAfterPendingDamage() const
+{
+    if (hasOrnaments)
+        return hp + qMin(0, ornHp - pendingDamage);
+    return ZombieInstance::hpAfterPendingDamage();
 }
 
 // 铁桶僵尸原型类构造函数
@@ -540,7 +592,7 @@ ConeheadZombieInstance::ConeheadZombieInstance(const Zombie *zombie)
 void ConeheadZombieInstance::playNormalballAudio()
 {
     if (hasOrnaments)
-        QSound::play(":/audio/plastichit.wav"); // 铁桶被击中音效
+        AudioManager::play(":/audio/plastichit.wav"); // 铁桶被击中音效
     else
         OrnZombieInstance1::playNormalballAudio(); // 无铁桶时使用基类音效
 }
@@ -555,9 +607,9 @@ void BucketheadZombieInstance::playNormalballAudio()
 {
     if (hasOrnaments) {
         if (qrand() % 2)
-            QSound::play(":/audio/shieldhit.wav"); // 铁桶被击中音效1
+            AudioManager::play(":/audio/shieldhit.wav"); // 铁桶被击中音效1
         else
-            QSound::play(":/audio/shieldhit2.wav"); // 铁桶被击中音效2
+            AudioManager::play(":/audio/shieldhit2.wav"); // 铁桶被击中音效2
     }
     else
         OrnZombieInstance1::playNormalballAudio(); // 无铁桶时使用基类音效
@@ -616,7 +668,7 @@ ScreenDoorZombieInstance::ScreenDoorZombieInstance(const Zombie *zombie)
 void ScreenDoorZombieInstance::playNormalballAudio() {
     if (hasOrnaments) {
         // 护甲被击中的金属声
-        QSound::play(":/audio/shieldhit2.wav");
+        AudioManager::play(":/audio/shieldhit2.wav");
     } else {
         // 本体被击中的默认音效
         ZombieInstance::playNormalballAudio();
@@ -658,6 +710,8 @@ PoleVaultingZombieInstance::PoleVaultingZombieInstance(const Zombie *zombie)
     judgeAttackOrig = false;                  // 是否使用原始攻击判定逻辑
     lostPole = false;                         // 是否丢弃撑杆
     beginCrushed = false;                     // 是否开始被压碎
+    vaultState = VaultRunning;                // 撑杆跳状态机
+    vaultTicks = 0;
 }
 
 // 获取撑杆僵尸原型（向下转型）
@@ -688,17 +742,14 @@ void PoleVaultingZombieInstance::judgeAttack()
         int colEnd = zombieProtoType->scene->getCoordinate().getCol(ZX);
         for (int col = colEnd - 2; col <= colEnd; ++col) {
             if (col > 9) continue;
-            QMap<int, PlantInstance *> plants = zombieProtoType->scene->getPlant(col, row);
-            // 从高优先级到低优先级检查植物
-            for (int i = 2; i >= 0; --i) {
-                if (!plants.contains(i)) continue;
-                PlantInstance *plant = plants[i];
+            // 从高优先级到低优先级检查可被啃食的植物
+            for (PlantInstance *plant: zombieProtoType->scene->getEatTargets(col, row)) {
                 // 检测到可攻击植物时准备跳跃
-                if (plant->attackedRX >= ZX - 74 && plant->attackedLX < ZX && plant->plantProtoType->canEat) {
+                if (plant->attackedRX >= ZX - 74 && plant->attackedLX < ZX) {
                     judgeAttackOrig = true;     // 标记为已触发跳跃
                     posX = plant->attackedLX;   // 记录植物左边界位置
                     normalAttack(plant);        // 执行跳跃攻击
-                    break;
+                    return;                     // 只跳一次
                 }
             }
         }
@@ -711,37 +762,36 @@ void PoleVaultingZombieInstance::normalAttack(PlantInstance *plantInstance)
     if (lostPole)                               // 已丢弃撑杆时使用基类攻击逻辑
         ZombieInstance::normalAttack(plantInstance);
     else {
-        QSound::play(":/audio/grassstep.wav");  // 播放准备跳跃音效
+        AudioManager::play(":/audio/grassstep.wav");  // 播放准备跳跃音效
         picture->setMovie(getZombieProtoType()->jumpGif1); // 设置起跳动画
         picture->start();
         shadowPNG->setVisible(false);           // 隐藏阴影（模拟腾空）
         isAttacking = true;                     // 标记为攻击状态
         altitude = 2;                           // 设置高度（空中）
 
-        // 0.5秒后播放跳跃音效
-        (new Timer(picture, 500, [] { QSound::play(":/audio/polevault.wav"); }))->start();
-
-        QUuid plantUuid = plantInstance->uuid;  // 记录目标植物UUID
+        // 1秒（10轮）后处理跳跃结果
+        vaultState = VaultJumping;
+        vaultTicks = 10;
+        vaultTarget = plantInstance->uuid;      // 记录目标植物UUID
+    }
+}
 
-        // 1秒后处理跳跃结果
-        (new Timer(picture, 1000, [this, plantUuid] {
-            PlantInstance *plant = zombieProtoType->scene->getPlant(plantUuid);
+void PoleVaultingZombieInstance::updateCooldowns()
+{
+    if (vaultState == VaultJumping) {
+        // 0.5秒后播放跳跃音效
+        if (--vaultTicks == 5)
+            AudioManager::play(":/audio/polevault.wav");
+        if (vaultTicks == 0) {
+            PlantInstance *plant = zombieProtoType->scene->getPlant(vaultTarget);
             if (plant && plant->plantProtoType->stature > 0) {
                 // 遇到高个子植物（如墙果）时直接跳过
                 attackedLX = ZX = plant->attackedRX;
                 X = attackedLX - zombieProtoType->beAttackedPointL;
                 attackedRX = X + zombieProtoType->beAttackedPointR;
                 picture->setX(X);
-                picture->setMovie(getZombieProtoType()->walkGif); // 设置丢弃撑杆后行走动画
-                picture->start();
                 shadowPNG->setVisible(true);    // 显示阴影
-                isAttacking = 0;                // 取消攻击状态
-                altitude = 1;                   // 高度恢复正常
-                orignSpeed = speed = 1.6;       // 速度提升（丢弃撑杆后）
-                normalGif = getZombieProtoType()->walkGif; // 更新普通动画
-                lostHeadGif = getZombieProtoType()->lostHeadWalkGif; // 更新失头动画
-                lostPole = true;                // 标记为已丢弃撑杆
-                judgeAttackOrig = true;         // 使用原始攻击判定逻辑
+                finishVault();
             }
             else {
                 // 遇到矮个子植物或空位置时执行落地动画
@@ -752,22 +802,29 @@ void PoleVaultingZombieInstance::normalAttack(PlantInstance *plantInstance)
                 picture->setMovie(getZombieProtoType()->jumpGif2); // 设置落地动画
                 picture->start();
                 shadowPNG->setVisible(true);
-
-                // 0.8秒后完成跳跃，更新状态
-                (new Timer(picture, 800, [this]{
-                    picture->setMovie(getZombieProtoType()->walkGif);
-                    picture->start();
-                    isAttacking = 0;
-                    altitude = 1;
-                    orignSpeed = speed = 1.6;
-                    normalGif = getZombieProtoType()->walkGif;
-                    lostHeadGif = getZombieProtoType()->lostHeadWalkGif;
-                    lostPole = true;
-                    judgeAttackOrig = true;
-                }))->start();
+                // 0.8秒（8轮）后完成跳跃
+                vaultState = VaultLanding;
+                vaultTicks = 8;
             }
-        }))->start();
+        }
     }
+    else if (vaultState == VaultLanding && --vaultTicks == 0)
+        finishVault();
+    ZombieInstance::updateCooldowns();
+}
+
+void PoleVaultingZombieInstance::finishVault()
+{
+    picture->setMovie(getZombieProtoType()->walkGif); // 设置丢弃撑杆后行走动画
+    picture->start();
+    isAttacking = 0;                            // 取消攻击状态
+    altitude = 1;                               // 高度恢复正常
+    orignSpeed = speed = 1.6;                   // 速度提升（丢弃撑杆后）
+    normalGif = getZombieProtoType()->walkGif;  // 更新普通动画
+    lostHeadGif = getZombieProtoType()->lostHeadWalkGif; // 更新失头动画
+    lostPole = true;                            // 标记为已丢弃撑杆
+    judgeAttackOrig = true;                     // 使用原始攻击判定逻辑
+    vaultState = VaultDone;
 }
 
 Zombie *ZombieFactory(GameScene *scene, const QString &ename)
@@ -5,6 +5,7 @@
 #include <QtWidgets>
 #include <QtMultimedia>
 #include "Plant.h"
+#include "StatusEffect.h"
 
 class MoviePixmapItem;
 class GameScene;
@@ -21,7 +22,7 @@ class Zombie
     Q_DECLARE_TR_FUNCTIONS(Zombie)
 public:
     Zombie();
-    virtual ~Zombie() {}
+    virtual ~Zombie();
 
     QString eName, cName;             // 僵尸的英文和中文名称
 
@@ -127,12 +128,18 @@ public:
     virtual void checkActs();                   // 检查行为状态
     virtual void judgeAttack();                 // 判断是否可以攻击
     virtual void normalAttack(PlantInstance *plant); // 普通攻击行为
+    virtual void updateCooldowns();             // 每轮监控推进啃食等冷却状态（在 checkActs 中调用）
     virtual void crushDie();                    // 被压碎死亡
     virtual void getPea(int attack, int direction); // 被普通豌豆击中
     virtual void getSnowPea(int attack, int direction); // 被冰冻豌豆击中
     virtual void getFirePea(int attack, int direction); // 被火球击中
-    virtual void getHit(int attack);            // 被普通攻击击中
+    void getHit(int attack);                    // 被普通攻击击中（伤害在下一轮监控时统一结算）
+    virtual void takeDamage(int damage);        // 结算本轮累计的伤害
+    virtual int hpAfterPendingDamage() const;   // 结算待处理伤害之后的生命值（子弹据此选择目标）
+    void startHitFlash();                       // 开始受击闪烁
     virtual void autoReduceHp();                // 自动减少生命值
+    void applyStatusEffect(StatusEffects::Type type, int ticks, int damage = 0, int period = 0); // 施加状态效果
+    virtual void updateStatusEffects();         // 推进一轮状态效果（由场景每轮监控调用）
     virtual void normalDie();                   // 普通死亡方式
     virtual void playNormalballAudio();         // 播放普通豌豆击中音效
     virtual void playSlowballAudio();           // 播放冰冻豌豆击中音效
@@ -143,10 +150,26 @@ public:
 
     QUuid uuid;                  // 唯一标识
     int hp;                      // 当前生命值
+    int pendingDamage;           // 本轮尚未结算的伤害
+    int hitFlash;                // 受击闪烁剩余时间（毫秒），由绘制时倒计时，0 表示未闪烁
+    bool statusEffectListed;     // 已登记在场景的状态效果列表中（效果清除后到下一轮更新前仍在列表中）
     qreal speed, orignSpeed;     // 当前速度和原始速度
     int attack, orignAttack;     // 当前攻击力和原始攻击力
     int altitude;                // 高度（用于判断是否能被某些攻击击中）
     bool beAttacked, isAttacking, goingDie; // 被攻击状态、攻击状态、死亡状态
+    bool dead;                   // 已死亡，等待本轮监控结束时释放
+    int instanceIndex;           // 在场景僵尸实例列表中的下标（用于交换删除）
+    // 触发检测的空闲区间：attackedLX 位于 (triggerFreeFrom, triggerFreeTo) 内且本行触发区域的版本仍为 triggerEpoch 时，
+    // 僵尸不在本行任何触发区域中，无需逐个检测（见 GameScene::needsTriggerCheck）
+    qreal triggerFreeFrom, triggerFreeTo;
+    quint32 triggerEpoch;
+
+    // 啃食状态机：EatIdle -> EatChewing（开始啃食时播放音效，BiteInterval 轮后咬下一口并重新判断目标）
+    enum EatState { EatIdle, EatChewing };
+    static const int BiteInterval = 10;     // 每口的间隔（轮，即1秒）
+    EatState eatState;
+    int eatTicks;                // 距咬下一口的轮数
+    QUuid eatTarget;             // 正在啃食的植物
 
     qreal X, ZX;                 // 位置坐标
     qreal attackedLX, attackedRX; // 受击范围
@@ -159,7 +182,7 @@ public:
     // 新增属性
     bool canJump;  // 是否能跳跃
 
-    QTimer *frozenTimer;          // 冰冻计时器
+    StatusEffects statusEffects;  // 状态效果（减速、持续掉血）
     QGraphicsPixmapItem *shadowPNG; // 阴影图片
     MoviePixmapItem *picture;     // 主图片
 };
@@ -187,7 +210,8 @@ class OrnZombieInstance1: public ZombieInstance
 public:
     OrnZombieInstance1(const Zombie *zombie);
     const OrnZombie1 *getZombieProtoType();
-    virtual void getHit(int attack); // 重写受击逻辑，处理装饰物
+    void takeDamage(int damage) override;        // 重写受击逻辑，处理装饰物
+    int hpAfterPendingDamage() const override;
 
     int ornHp;                     // 装饰物当前生命值
     bool hasOrnaments;             // 是否还有装饰物
@@ -294,11 +318,21 @@ public:
     virtual QPointF getDieingHeadPos();       // 重写死亡头部位置
     virtual void judgeAttack();               // 重写攻击判断
     virtual void normalAttack(PlantInstance *plantInstance); // 重写攻击行为
+    void updateCooldowns() override;          // 推进撑杆跳状态
     const PoleVaultingZombie *getZombieProtoType(); // 获取原型
 
+    // 撑杆跳状态机：VaultRunning -> VaultJumping（10轮）-> [VaultLanding（8轮，越过矮植物时）] -> VaultDone
+    enum VaultState { VaultRunning, VaultJumping, VaultLanding, VaultDone };
+
     // 特殊状态变量
     bool judgeAttackOrig, lostPole, beginCrushed;
     qreal posX; // 用于传递位置信息到攻击函数
+    VaultState vaultState;
+    int vaultTicks;              // 当前阶段剩余轮数
+    QUuid vaultTarget;           // 起跳时面对的植物
+
+private:
+    void finishVault();          // 跳跃完成：丢弃撑杆，以更快速度行走
 };
 
 // 僵尸工厂函数，用于创建僵尸原型
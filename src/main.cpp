@@ -6,9 +6,19 @@
 #include "MainView.h"
 #include "SelectorScene.h"
 #include "ImageManager.h"
+#include "GameScene.h"
+#include "StressScenario.h"
+#include "TraceRecorder.h"
+#include "ObjectCounter.h"
+#include "StartupReport.h"
+#include "JobSystem.h"
 
 int main(int argc, char * *argv)
 {
+    // 启动计时从进入 main 开始（只在 --startup-report 时输出）
+    QElapsedTimer startupClock;
+    startupClock.start();
+
     // 创建 Qt 应用程序实例
     QApplication app(argc, argv);
 
@@ -24,27 +34,103 @@ int main(int argc, char * *argv)
     appTranslator.load(QString(":/translations/main.%1.qm").arg("zh_CN"));
     app.installTranslator(&appTranslator);
 
+    // 命令行参数：--stress 直接进入压力测试场景
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption stressOption("stress",
+            "Start a stress scenario, e.g. \"plants=oPeashooter,cols=5,zombies=oZombie,count=500,report=1000\".",
+            "spec");
+    parser.addOption(stressOption);
+    QCommandLineOption traceOption("trace",
+            "Record trace events and write them as Chrome trace JSON to <file> on exit.", "file");
+    QCommandLineOption traceBufferOption("trace-buffer",
+            "Number of trace events kept in the ring buffer (default 1000000).", "events", "1000000");
+    parser.addOption(traceOption);
+    parser.addOption(traceBufferOption);
+    QCommandLineOption startupReportOption("startup-report",
+            "Print the time spent in each startup phase to stderr once the first frame is shown.");
+    parser.addOption(startupReportOption);
+    QCommandLineOption jobsOption("jobs",
+            "Split per-tick simulation work across <threads> worker threads (default 0: single-threaded).",
+            "threads", "0");
+    parser.addOption(jobsOption);
+    parser.process(app);
+
+    if (parser.isSet(startupReportOption)) {
+        InitStartupReport(startupClock);
+        STARTUP_PHASE("application and options");
+    }
+
+    StressScenario *stressScenario = nullptr;
+    if (parser.isSet(stressOption)) {
+        QString error;
+        stressScenario = StressScenario::fromSpec(parser.value(stressOption), &error);
+        if (!stressScenario) {
+            qCritical().noquote() << error;
+            return 1;
+        }
+        stressScenario->setParent(&app);
+    }
+
+    // 开启追踪记录（在创建任何场景之前，以便记录启动阶段）
+    if (parser.isSet(traceOption))
+        InitTraceRecorder(qMax(1, parser.value(traceBufferOption).toInt()));
+
+    // 每轮监控的并行线程池（未指定时保持单线程）
+    InitJobSystem(parser.value(jobsOption).toInt());
+
     // 初始化图像管理器
     InitImageManager();
+    STARTUP_PHASE("image manager");
 
     // 初始化随机数种子
     qsrand((uint) QTime::currentTime().msec());
 
     // 创建主窗口实例
     MainWindow mainWindow;
+    STARTUP_PHASE("main window");
 
-    // 切换到选择场景
-    gMainView->switchToScene(new SelectorScene);
+    // 切换到选择场景（压力测试时直接进入测试关卡）
+    if (stressScenario)
+        gMainView->switchToScene(new GameScene(stressScenario->createLevel()));
+    else
+        gMainView->switchToScene(new SelectorScene);
+    STARTUP_PHASE("first scene");
+
+    // 首个场景建立后记录对象计数基线，之后每次退出关卡都与之比较
+    QTimer::singleShot(0, [] { ObjectCounter::setBaseline(); });
 
     // 设置主窗口标题
     mainWindow.setWindowTitle("121植物大战僵尸");
 
     // 显示主窗口
     mainWindow.show();
+    STARTUP_PHASE("window shown");
+
+    // 首帧之后延后的加载（由各场景登记，先于此处执行）完成后输出启动报告
+    if (gStartupReport) {
+        gMainView->runAfterNextFrame([] {
+            STARTUP_PHASE("deferred loading");
+            gStartupReport->write();
+            DestroyStartupReport();
+        });
+    }
 
     // 进入应用程序事件循环
     int res = app.exec();
 
+    // 导出追踪记录
+    if (gTraceRecorder) {
+        if (!gTraceRecorder->writeJson(parser.value(traceOption)))
+            qWarning().noquote() << "Cannot write trace file" << parser.value(traceOption);
+        DestroyTraceRecorder();
+    }
+
+    DestroyJobSystem();
+
+    // 首帧未能显示时启动报告仍未输出，这里一并释放
+    DestroyStartupReport();
+
     // 销毁图像管理器
     DestoryImageManager();
 
@@ -0,0 +1,27 @@
+# 游戏主体源文件列表（主程序与 bench 等工具共用，main.cpp 由各自的工程单独添加）
+
+INCLUDEPATH += $$PWD
+
+# Coordinate 的查找表在编译期生成，需要 C++14 的 constexpr
+CONFIG += c++14
+
+HEADERS +=              $$PWD/MainView.h   $$PWD/SelectorScene.h   $$PWD/MouseEventPixmapItem.h   $$PWD/GameScene.h   \
+                        $$PWD/GameLevelData.h   $$PWD/Plant.h   $$PWD/Zombie.h   $$PWD/Timer.h   $$PWD/ImageManager.h   \
+                        $$PWD/PlantCardItem.h   $$PWD/Coordinate.h   $$PWD/AspectRatioLayout.h   $$PWD/Animate.h \
+                        $$PWD/ZombieInfoScene.h   $$PWD/StressScenario.h \
+                        $$PWD/AudioManager.h   $$PWD/PerfMonitor.h   $$PWD/PerfHud.h   $$PWD/TraceRecorder.h   $$PWD/ObjectCounter.h \
+                        $$PWD/StartupReport.h   $$PWD/JobSystem.h \
+                        $$PWD/GameClock.h       $$PWD/StatusEffect.h \
+                        $$PWD/ProductionScheduler.h \
+                        $$PWD/TweenEngine.h   $$PWD/SimulationChannel.h
+SOURCES +=              $$PWD/MainView.cpp $$PWD/SelectorScene.cpp $$PWD/MouseEventPixmapItem.cpp $$PWD/GameScene.cpp \
+                        $$PWD/GameLevelData.cpp $$PWD/Plant.cpp $$PWD/Zombie.cpp $$PWD/Timer.cpp $$PWD/ImageManager.cpp \
+                        $$PWD/PlantCardItem.cpp $$PWD/Coordinate.cpp $$PWD/AspectRatioLayout.cpp $$PWD/Animate.cpp \
+                        $$PWD/zombieinfoscene.cpp $$PWD/StressScenario.cpp \
+                        $$PWD/AudioManager.cpp $$PWD/PerfMonitor.cpp $$PWD/PerfHud.cpp $$PWD/TraceRecorder.cpp $$PWD/ObjectCounter.cpp \
+                        $$PWD/StartupReport.cpp $$PWD/JobSystem.cpp \
+                        $$PWD/GameClock.cpp $$PWD/StatusEffect.cpp $$PWD/ProductionScheduler.cpp \
+                        $$PWD/TweenEngine.cpp
+
+# StressScenario 在 Windows 下通过 psapi 读取内存占用
+win32: LIBS += -lpsapi